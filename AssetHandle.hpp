@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+/*
+ *      AssetHandle - nazwa zasobu rozwiązana raz, przy ładowaniu
+ *  Uchwyt to jedynie indeks w tablicy zasobów AssetManagera, więc dostęp do zasobu w pętli gry
+ *  nie wymaga budowania stringa ani przeszukiwania hashmapy. Parametr szablonu rozróżnia typy
+ *  uchwytów, by np. uchwytu czcionki nie dało się użyć jako tekstury.
+ */
+template<class Tag>
+struct AssetHandle {
+	static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+	std::uint32_t index {invalidIndex};
+
+	bool valid() const { return index != invalidIndex; }
+	explicit operator bool() const { return valid(); }
+
+	bool operator==(const AssetHandle& other) const { return index == other.index; }
+	bool operator!=(const AssetHandle& other) const { return index != other.index; }
+};
+
+struct TextureHandleTag {};
+struct FontHandleTag {};
+struct JsonHandleTag {};
+
+typedef AssetHandle<TextureHandleTag> TextureHandle;
+typedef AssetHandle<FontHandleTag> FontHandle;
+typedef AssetHandle<JsonHandleTag> JsonHandle;
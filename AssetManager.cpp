@@ -1,7 +1,18 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 #include "World/Map.hpp"
+#include "World/ItemRegistry.hpp"
+#include "World/Item.hpp"
+#include "Entity/Script.hpp"
 #include "AssetManager.hpp"
+#include "SaveFormat.hpp"
+#include "Sound/SoundEngine.hpp"
+#include "Profiler.hpp"
 
 /*
  *  Importuje nową spritesheet z dysku
@@ -11,8 +22,19 @@
  *  plik graficzny, np. playersprite.png, wtedy pobieranie tekstur odbywa się za pomocą samej nazwy a nie nazwy pliku)
  */
 bool AssetManager::addSpritesheet(const std::string &resourcePath, std::unordered_map<std::string, Spritesheet>& map, Vec2u (*partitioner)(Vec2u textureSize)) {
+	sf::Image image;
+	if (!image.loadFromFile(resourcePath)) return false;
+
+	return addSpritesheet(resourcePath, image, map, partitioner);
+}
+
+/*
+ *  Tworzy spritesheet z już zdekodowanego obrazu - jedynie wysyła teksturę na GPU,
+ *  więc musi być wołane z głównego wątku
+ */
+bool AssetManager::addSpritesheet(const std::string &resourcePath, const sf::Image& image, std::unordered_map<std::string, Spritesheet>& map, Vec2u (*partitioner)(Vec2u textureSize)) {
 	sf::Texture texture;
-	if (!texture.loadFromFile(resourcePath)) return false;
+	if (!texture.loadFromImage(image)) return false;
 
 	std::string resourceName = AssetManager::getFilenameFromPath(resourcePath);
 
@@ -23,24 +45,19 @@ bool AssetManager::addSpritesheet(const std::string &resourcePath, std::unordere
 		defaultDimensions = partitioner(texture.getSize());
 	}
 
-	Spritesheet spritesheet(std::move(texture), defaultDimensions);
-	map[resourceName] = spritesheet;
+	map[resourceName] = Spritesheet(std::move(texture), defaultDimensions);
 
 	return true;
 }
 
 
 bool AssetManager::addJsonFile(const std::string &resourcePath) {
-	std::ifstream file;
-	file.open(resourcePath);
-	if(!file.good()) {
-		file.close();
+	std::string json;
+	if(!readResource(resourcePath, json)) {
 		std::cerr << "AssetManager::addJsonFile() failed loading '" << resourcePath << "'\n";
 		std::cerr << "Details: Error reading from file\n";
 		return false;
 	}
-	std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-	file.close();
 
 	std::string name = AssetManager::getFilenameFromPath(resourcePath);
 
@@ -57,74 +74,337 @@ bool AssetManager::addJsonFile(const std::string &resourcePath) {
 }
 
 
+/*
+ *  Ładuje czcionkę do wspólnego cache
+ *  Cały plik wczytywany jest do pamięci - sf::Font::loadFromFile zostawia otwarty plik i doczytuje z niego
+ *  przy renderowaniu nowych glifów, co oznaczałoby dostęp do dysku w trakcie gry.
+ */
 bool AssetManager::addFont(const std::string &resourcePath) {
-	sf::Font font;
-	if(!font.loadFromFile(resourcePath))
+	std::string name = AssetManager::getFilenameFromPath(resourcePath);
+
+	//  Z paczki czcionka czytana jest bezpośrednio ze zmapowanej pamięci, bez kopii
+	if(auto packed = findPacked(resourcePath)) {
+		if(!fonts[name].loadFromMemory(packed.data, packed.size)) {
+			std::cerr << "AssetManager::addFont() failed parsing '" << resourcePath << "'\n";
+			fonts.erase(name);
+			return false;
+		}
+		return true;
+	}
+
+	std::ifstream file(resourcePath, std::ios::binary);
+	if(!file.good()) {
+		std::cerr << "AssetManager::addFont() failed loading '" << resourcePath << "'\n";
 		return false;
+	}
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	file.close();
 
-	std::string name = AssetManager::getFilenameFromPath(resourcePath);
-	fonts[name] = font;
+	auto& buffer = fontData[name];
+	buffer = std::move(data);
+
+	if(!fonts[name].loadFromMemory(buffer.data(), buffer.size())) {
+		std::cerr << "AssetManager::addFont() failed parsing '" << resourcePath << "'\n";
+		fonts.erase(name);
+		fontData.erase(name);
+		return false;
+	}
+
+	return true;
+}
+
+
+static Vec2u tilesetPartitioner(Vec2u) {
+	return Vec2u{32, 32};
+}
+
+/*
+ *  Obraz czekający na zdekodowanie w tle i wysłanie na GPU
+ */
+struct PendingImage {
+	std::string path;
+	const char* kind;
+	std::unordered_map<std::string, Spritesheet>* target;
+	Vec2u (*partitioner)(Vec2u textureSize);
+	AssetPack::Resource packed {};
+	sf::Image image;
+	bool decoded {false};
+};
+
+/*
+ *  Obrazy z paczki są już zdekodowane - wystarczy skopiować piksele
+ */
+static bool decodeImage(PendingImage& pending) {
+	if(!pending.packed)
+		return pending.image.loadFromFile(pending.path);
+
+	if(pending.packed.kind != AssetPack::Kind::Image || pending.packed.size < 2 * sizeof(std::uint32_t))
+		return pending.image.loadFromMemory(pending.packed.data, pending.packed.size);
+
+	std::uint32_t size[2];
+	std::memcpy(size, pending.packed.data, sizeof(size));
+	if(pending.packed.size - sizeof(size) != (std::size_t)size[0] * size[1] * 4)
+		return false;
 
+	pending.image.create(size[0], size[1], reinterpret_cast<const sf::Uint8*>(pending.packed.data + sizeof(size)));
 	return true;
 }
 
+/*
+ *  Wątki dekodujące - dołączane najpóźniej przy wyjściu z zakresu, także gdy ładowanie przerwie
+ *  wyjątek (zniszczenie wciąż podłączonego std::thread kończy program)
+ */
+struct DecodeWorkers {
+	std::vector<std::thread> threads;
+
+	DecodeWorkers() = default;
+	DecodeWorkers(const DecodeWorkers&) = delete;
+	DecodeWorkers& operator=(const DecodeWorkers&) = delete;
+	~DecodeWorkers() { join(); }
+
+	void join() {
+		for(auto& thread : threads)
+			if(thread.joinable()) thread.join();
+	}
+};
+
+/*
+ *  Dekoduje wszystkie obrazy na puli wątków - sf::Image nie korzysta z kontekstu OpenGL,
+ *  więc dekodowanie PNG może odbywać się poza głównym wątkiem
+ */
+static void decodeImages(std::vector<PendingImage>& images, std::atomic<std::size_t>& next, DecodeWorkers& workers) {
+	const unsigned count = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(), images.size()));
+	for(unsigned i = 0; i < count; ++i) {
+		workers.threads.emplace_back([&images, &next]() {
+			PROFILE_THREAD("Asset decode");
+			for(std::size_t job = next++; job < images.size(); job = next++) {
+				PROFILE_SCOPE("Decode image");
+				try {
+					images[job].decoded = decodeImage(images[job]);
+				} catch (const std::exception&) {
+					//  Wyjątek opuszczający wątek kończy program - obraz zostaje oznaczony jako nieudany
+					images[job].decoded = false;
+				}
+			}
+		});
+	}
+}
 
 /*
  *  Automatycznie ładuje z folderu GameContent wszystkie możliwe tekstury
+ *  PNG dekodowane są równolegle w tle, a w tym czasie główny wątek ładuje konfiguracje i czcionki.
+ *  Na GPU tekstury wysyłane są już na głównym wątku.
+ *  Jeśli obok gry leży paczka zasobów (GameContent.pack), wszystko czytane jest z niej,
+ *  w przeciwnym razie - z luźnych plików (tryb deweloperski).
  */
 void AssetManager::autoload() {
 	namespace fs = std::filesystem;
+	using clock = std::chrono::steady_clock;
 	sf::Context context;
 
-	//  Ładowanie Tileset'ow
-	for(const auto& entry : fs::directory_iterator("GameContent/Tilesets/")) {
-		if(entry.is_regular_file()) {
-			if(entry.path().extension() == ".png") {
-				std::cout << "AssetManager::autoload()/ Adding tileset " << entry.path().filename() << "\n";
-				addSpritesheet(entry.path().string(), tilesets, [](Vec2u) -> Vec2u{
-					return Vec2u{32, 32};
-				});
-			} else if(entry.path().extension() == ".json") {
-				std::cout << "AssetManager::autoload()/ Adding tileset configuration " << entry.path().filename() << "\n";
-				addJsonFile(entry.path().string());
-			}
+	if(pack.open(AssetPack::defaultPath))
+		std::cout << "AssetManager::autoload()/ Using asset pack '" << AssetPack::defaultPath << "'\n";
+
+	std::vector<std::pair<const char*, clock::duration>> phases;
+	const auto loadStart = clock::now();
+	auto phaseStart = loadStart;
+	auto endPhase = [&phases, &phaseStart](const char* name) {
+		const auto now = clock::now();
+		phases.emplace_back(name, now - phaseStart);
+		phaseStart = now;
+	};
+
+	std::vector<PendingImage> images;
+	std::vector<std::string> jsonFiles;
+	std::vector<std::string> fontFiles;
+
+	auto extension = [](const std::string& path) { return fs::path(path).extension(); };
+
+	//  Tilesety
+	for(const auto& path : listResources("GameContent/Tilesets/")) {
+		if(extension(path) == ".png") {
+			images.push_back({path, "tileset", &tilesets, tilesetPartitioner});
+		} else if(extension(path) == ".json") {
+			jsonFiles.push_back(path);
 		}
 	}
 
-	//  Ładowanie postaci
-	for(const auto& entry : fs::directory_iterator("GameContent/Characters/")) {
-		if(entry.is_regular_file() && entry.path().extension() == ".png") {
-			std::cout << "AssetManager::autoload()/ Adding character " << entry.path().filename() << "\n";
-			addSpritesheet(entry.path().string(), characters, [](Vec2u textureSize) -> Vec2u{
+	//  Postacie
+	for(const auto& path : listResources("GameContent/Characters/")) {
+		if(extension(path) == ".png") {
+			images.push_back({path, "character", &characters, [](Vec2u textureSize) -> Vec2u{
 				return textureSize/4u;
-			});
+			}});
 		}
 	}
 
-	//  Ładowanie elementów UI
-	for(const auto& entry : fs::directory_iterator("GameContent/UI/")) {
-		if(entry.is_regular_file() && entry.path().extension() == ".png") {
-			std::cout << "AssetManager::autoload()/ Adding UI element " << entry.path().filename() << "\n";
-			addSpritesheet(entry.path().string(), UI);
+	//  Elementy UI
+	for(const auto& path : listResources("GameContent/UI/")) {
+		if(extension(path) == ".png") {
+			images.push_back({path, "UI element", &UI, nullptr});
 		}
 	}
 
-	//  Ładowanie czcionek
-	for(const auto& entry : fs::directory_iterator("GameContent/Fonts/")) {
-		if(entry.is_regular_file()) {
-			std::cout << "AssetManager::autoload()/ Adding font " << entry.path().filename() << "\n";
-			addFont(entry.path().string());
-		}
+	//  Czcionki
+	for(const auto& path : listResources("GameContent/Fonts/")) {
+		fontFiles.push_back(path);
 	}
 
-	addSpritesheet("GameContent/ItemList.png", UI, [](Vec2u size) -> Vec2u {
+	images.push_back({"GameContent/ItemList.png", "item list", &UI, [](Vec2u size) -> Vec2u {
 		return { 32,32};
-	});
-	addJsonFile("GameContent/ItemList.json");
+	}});
+	for(auto& pending : images)
+		pending.packed = findPacked(pending.path);
+	endPhase("scan");
+
+	std::atomic<std::size_t> nextImage {0};
+	DecodeWorkers workers;
+	decodeImages(images, nextImage, workers);
+
+	for(const auto& path : jsonFiles) {
+		std::cout << "AssetManager::autoload()/ Adding tileset configuration " << fs::path(path).filename() << "\n";
+		addJsonFile(path);
+	}
+	for(const auto& path : fontFiles) {
+		std::cout << "AssetManager::autoload()/ Adding font " << fs::path(path).filename() << "\n";
+		addFont(path);
+	}
+	endPhase("configs and fonts (overlapped with decode)");
+
+	workers.join();
+	endPhase("image decode (remaining)");
 
-	loadSavefile("GameContent/Savegame.json");
+	for(auto& pending : images) {
+		if(!pending.decoded) {
+			std::cerr << "AssetManager::autoload()/ Failed decoding " << pending.kind << " '" << pending.path << "'\n";
+			continue;
+		}
+		std::cout << "AssetManager::autoload()/ Adding " << pending.kind << " " << fs::path(pending.path).filename() << "\n";
+		addSpritesheet(pending.path, pending.image, *pending.target, pending.partitioner);
+	}
+	images.clear();
+	endPhase("texture upload");
+
+	if(addJsonFile("GameContent/ItemList.json"))
+		ItemRegistry::compile(config["ItemList"]);
+	endPhase("item registry");
+
+	//  Opcjonalne limity pamięci - bez pliku zasoby nie są zwalniane
+	std::string budget;
+	if(readResource("GameContent/MemoryBudget.json", budget)) {
+		try {
+			MemoryBudget::configure(nlohmann::json::parse(budget));
+		} catch (std::exception& ex) {
+			std::cerr << "AssetManager::autoload()/ Failed parsing memory budget: " << ex.what() << "\n";
+		}
+	}
+
+	//  Stare zapisy w JSON są wczytywane jeśli brak binarnego - kolejny zapis przekonwertuje je do nowego formatu
+	if(!loadSavefile(SaveWriter::defaultPath()))
+		loadSavefile(SaveWriter::legacyPath());
+
+	//  Zmiany z autozapisów od ostatniego pełnego zapisu
+	if(auto records = SaveWriter::replayJournal(savefile))
+		std::cout << "AssetManager::autoload()/ Replayed " << records << " save journal records\n";
+	endPhase("savegame");
+
+	warmGlyphs();
+	endPhase("glyph warmup");
+
+	using ms = std::chrono::duration<double, std::milli>;
+	std::cout << "AssetManager::autoload()/ Startup timing:\n";
+	for(const auto& [name, time] : phases)
+		std::cout << "\t" << name << ": " << ms(time).count() << " ms\n";
+	std::cout << "\ttotal: " << ms(clock::now() - loadStart).count() << " ms\n";
+}
+
+
+/*
+ *  Zestaw glifów rasteryzowanych przy ładowaniu - czcionka, rozmiary i grubość obrysu
+ *  (obrys jest osobnym glifem w cache SFML). Wszystkie czcionki dostają ASCII oraz polskie znaki.
+ */
+struct GlyphWarmup {
+	const char* font;
+	std::vector<unsigned> sizes;
+	float outline;
+};
+
+static const std::vector<GlyphWarmup> s_glyph_warmup = {
+	{"VCR_OSD_MONO",          {12, 14, 16, 18, 19, 20, 21, 24, 28, 30}, 0.0f},
+	{"ConnectionSerif",       {10}, 1.2f},
+	{"Browser-Cyberlink-New", {15, 16}, 0.0f},
+	{"arial",                 {32}, 0.0f},
+};
+
+static const std::vector<std::pair<std::uint32_t, std::uint32_t>> s_glyph_ranges = {
+	{0x20, 0x7E},	//  ASCII
+	{0xD3, 0xD3},	//  Ó
+	{0xF3, 0xF3},	//  ó
+	{0x104, 0x107},	//  Ą ą Ć ć
+	{0x118, 0x119},	//  Ę ę
+	{0x141, 0x144},	//  Ł ł Ń ń
+	{0x15A, 0x15B},	//  Ś ś
+	{0x179, 0x17C},	//  Ź ź Ż ż
+};
+
+std::uint64_t AssetManager::glyphKey(std::uint32_t codePoint, unsigned characterSize, bool bold, float outline) {
+	return (std::uint64_t)codePoint
+	       | ((std::uint64_t)(characterSize & 0x3FF) << 21)
+	       | ((std::uint64_t)((unsigned)(outline * 10.0f) & 0xFF) << 31)
+	       | ((std::uint64_t)bold << 39);
+}
+
+void AssetManager::warmGlyphs() {
+	unsigned count = 0;
+	for(const auto& entry : s_glyph_warmup) {
+		auto it = fonts.find(entry.font);
+		if(it == fonts.end()) {
+			std::cerr << "AssetManager::warmGlyphs()/ Font '" << entry.font << "' not loaded, skipping\n";
+			continue;
+		}
+
+		auto& font = it->second;
+		auto& seen = glyphsSeen[&font];
+		for(auto size : entry.sizes) {
+			for(const auto& [first, last] : s_glyph_ranges) {
+				for(auto codePoint = first; codePoint <= last; ++codePoint) {
+					font.getGlyph(codePoint, size, false, 0.0f);
+					seen.insert(glyphKey(codePoint, size, false, 0.0f));
+					if(entry.outline > 0.0f) {
+						font.getGlyph(codePoint, size, false, entry.outline);
+						seen.insert(glyphKey(codePoint, size, false, entry.outline));
+					}
+					++count;
+				}
+			}
+		}
+	}
+	std::cout << "AssetManager::warmGlyphs()/ Rasterized " << count << " glyphs\n";
 }
 
+#ifdef RPG_PROFILING
+void AssetManager::trackGlyphs(const sf::Text& text) {
+	const sf::Font* font = text.getFont();
+	if(!font) return;
+
+	auto& manager = get();
+	auto& seen = manager.glyphsSeen[font];
+	const bool bold = text.getStyle() & sf::Text::Bold;
+	const unsigned size = text.getCharacterSize();
+	const float outline = text.getOutlineThickness();
+
+	for(auto codePoint : text.getString()) {
+		if(codePoint == '\n' || codePoint == '\t') continue;
+
+		bool miss = seen.insert(glyphKey(codePoint, size, bold, 0.0f)).second;
+		if(outline > 0.0f)
+			miss |= seen.insert(glyphKey(codePoint, size, bold, outline)).second;
+
+		if(miss) ++manager.glyphMisses;
+	}
+}
+#endif
+
 
 std::string AssetManager::getFilenameFromPath(const std::string &path) {
 	std::string name = path;
@@ -138,11 +418,74 @@ std::string AssetManager::getFilenameFromPath(const std::string &path) {
 	return name;
 }
 
+std::vector<std::string> AssetManager::sortedNames(const std::unordered_map<std::string, Spritesheet>& map) {
+	std::vector<std::string> names;
+	names.reserve(map.size());
+	for(const auto& entry : map)
+		names.push_back(entry.first);
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+/*
+ *  Zamienia ścieżkę "GameContent/..." na nazwę wpisu w paczce
+ */
+static bool packEntryName(const std::string& resourcePath, std::string& entry) {
+	static const std::string root = "GameContent/";
+	if(resourcePath.compare(0, root.size(), root) != 0) return false;
+	entry = resourcePath.substr(root.size());
+	std::replace(entry.begin(), entry.end(), '\\', '/');
+	return true;
+}
+
+AssetPack::Resource AssetManager::findPacked(const std::string& resourcePath) const {
+	std::string entry;
+	if(!pack.isOpen() || !packEntryName(resourcePath, entry)) return {};
+	return pack.find(entry);
+}
+
+/*
+ *  Czyta zasób z paczki, a jeśli ta nie jest używana (lub go nie zawiera) - z luźnego pliku
+ */
+bool AssetManager::readResource(const std::string& resourcePath, std::string& contents) const {
+	if(auto packed = findPacked(resourcePath)) {
+		contents.assign(packed.data, packed.size);
+		return true;
+	}
+
+	std::ifstream file(resourcePath, std::ios::binary);
+	if(!file.good()) return false;
+	contents.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return true;
+}
+
+/*
+ *  Pliki w danym katalogu - z indeksu paczki, lub skanując katalog na dysku
+ */
+std::vector<std::string> AssetManager::listResources(const std::string& directory) const {
+	std::vector<std::string> result;
+
+	std::string entry;
+	if(pack.isOpen() && packEntryName(directory, entry)) {
+		for(auto& name : pack.list(entry))
+			result.push_back("GameContent/" + name);
+		return result;
+	}
+
+	namespace fs = std::filesystem;
+	std::error_code ec;
+	for(const auto& file : fs::directory_iterator(directory, ec)) {
+		if(file.is_regular_file())
+			result.push_back(file.path().generic_string());
+	}
+	return result;
+}
+
 bool AssetManager::addMap(const std::string& resourcePath) {
 	try {
-		auto map = std::make_shared<Map>(Map::from_file(getFilenameFromPath(resourcePath)));
+		auto map = Map::from_file(getFilenameFromPath(resourcePath));
 		map->initializeVertexArrays();
-		maps[getFilenameFromPath(resourcePath)] = map;
+		maps[getFilenameFromPath(resourcePath)] = std::move(map);
 	} catch (std::exception& e) {
 		std::cout << e.what() << "\n";
 		return false;
@@ -151,33 +494,172 @@ bool AssetManager::addMap(const std::string& resourcePath) {
 	return true;
 }
 
+/*
+ *  Mapa zwolniona przez limit pamięci jest przebudowywana przy pierwszym ponownym użyciu
+ */
+std::shared_ptr<Map> AssetManager::getMap(const std::string& name) {
+	auto& manager = get();
+	auto it = manager.maps.find(name);
+	if(it == manager.maps.end()) {
+		std::cerr << "Map '" << name << "' does not exist!\n";
+		throw std::runtime_error("Requested non-existant map '" + name + "'");
+	}
+
+	if(!it->second->hasBuffers())
+		it->second->initializeVertexArrays();
+	manager.mapLastUse[name] = ++manager.mapClock;
+	return it->second;
+}
+
 void AssetManager::loadMaps() {
 	namespace fs = std::filesystem;
 	//  Ładowanie map
-	for(const auto& entry : fs::directory_iterator("GameContent/Map/")) {
-		if(entry.is_regular_file() && entry.path().extension() == ".json") {
-			if(get().addMap(entry.path().string()))
-				std::cout << "AssetManager::autoload()/ Adding map " << entry.path().filename() << "\n";
+	for(const auto& path : get().listResources("GameContent/Map/")) {
+		if(fs::path(path).extension() == ".json") {
+			if(get().addMap(path))
+				std::cout << "AssetManager::autoload()/ Adding map " << fs::path(path).filename() << "\n";
 		}
 	}
 }
 
 bool AssetManager::loadSavefile(const std::string& resourcePath) {
 	std::ifstream file;
-	file.open(resourcePath);
+	file.open(resourcePath, std::ios::binary);
 	if(!file.good()) {
 		savefile = {};
 		file.close();
 		return false;
 	}
-	std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
 	file.close();
 
-	try {
-		auto j = nlohmann::json::parse(json);
-		savefile = j;
-	} catch (std::exception& ex) {
-		savefile = {};
+	if(SaveFormat::isBinary(data)) {
+		if(!SaveFormat::decode(data, savefile)) {
+			std::cerr << "AssetManager::loadSavefile()/ Savegame '" << resourcePath << "' is corrupted\n";
+			savefile = {};
+		}
+	} else {
+		try {
+			savefile = nlohmann::json::parse(data.begin(), data.end());
+		} catch (std::exception& ex) {
+			savefile = {};
+		}
 	}
+
+	std::cout << "AssetManager::loadSavefile()/ Loaded '" << resourcePath << "' in "
+	          << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms\n";
 	return true;
 }
+
+ReloadResult AssetManager::reloadAsset(const AssetChange& change) {
+	auto& manager = get();
+	switch(change.kind) {
+		case AssetKind::Map: {
+			auto it = manager.maps.find(change.name);
+			//  Nowa mapa - dodawana tak jak przy starcie
+			if(it == manager.maps.end())
+				return manager.addMap(change.path) ? ReloadResult::Reloaded : ReloadResult::Failed;
+			return it->second->reload(change.name);
+		}
+		case AssetKind::Tileset: {
+			//  Tekstura podmieniana jest w istniejącym spritesheecie, więc TileSety i uchwyty pozostają ważne
+			const bool loaded = std::filesystem::path(change.path).extension() == ".png"
+			                    ? manager.addSpritesheet(change.path, manager.tilesets, tilesetPartitioner)
+			                    : manager.addJsonFile(change.path);
+			if(!loaded) return ReloadResult::Failed;
+
+			bool failed = false;
+			for(auto& entry : manager.maps) {
+				if(entry.second->getTilesetName() == change.name)
+					failed |= !entry.second->reloadTileset();
+			}
+			return failed ? ReloadResult::Failed : ReloadResult::Reloaded;
+		}
+		case AssetKind::Script: {
+			const bool loaded = Script::reloadAll(change.name);
+			Item::refreshScripts();
+			return loaded ? ReloadResult::Reloaded : ReloadResult::Failed;
+		}
+		case AssetKind::ItemList: {
+			if(!manager.addJsonFile(change.path)) return ReloadResult::Failed;
+			ItemRegistry::reload(manager.config["ItemList"]);
+			Item::refreshScripts();
+			return ReloadResult::Reloaded;
+		}
+	}
+	return ReloadResult::Failed;
+}
+
+MemoryReport AssetManager::measureMemory() {
+	auto& manager = get();
+	MemoryReport report;
+
+	auto& textures = report[MemoryCategory::Textures];
+	for(auto* sheets : {&manager.tilesets, &manager.characters, &manager.UI}) {
+		for(const auto& entry : *sheets) {
+			const auto size = entry.second.getTexture().getSize();
+			textures.gpu += (std::size_t)size.x * size.y * 4;
+			++textures.count;
+		}
+	}
+
+	auto& vertexBuffers = report[MemoryCategory::VertexBuffers];
+	for(const auto& entry : manager.maps) {
+		vertexBuffers.gpu += entry.second->gpuMemory();
+		vertexBuffers.cpu += entry.second->cpuMemory();
+		++vertexBuffers.count;
+	}
+
+	if(SoundEngine::exists())
+		report[MemoryCategory::SoundBuffers] = SoundEngine::get().bufferMemory();
+
+	auto& documents = report[MemoryCategory::Json];
+	for(const auto& entry : manager.config) {
+		documents.cpu += MemoryBudget::estimateJson(entry.second);
+		++documents.count;
+	}
+	documents.cpu += MemoryBudget::estimateJson(manager.savefile);
+	++documents.count;
+
+	report[MemoryCategory::Lua] = Script::memoryUsage();
+
+	return report;
+}
+
+void AssetManager::enforceMemoryBudget() {
+	PROFILE_SCOPE("Memory budget");
+	auto& manager = get();
+
+	//  Mapy - zwalniane od najdawniej używanej, z pominięciem map trzymanych poza AssetManagerem
+	//  (aktualna mapa świata, mapa otwarta w edytorze)
+	if(const auto budget = MemoryBudget::getBudget(MemoryCategory::VertexBuffers)) {
+		std::size_t used = 0;
+		for(const auto& entry : manager.maps)
+			used += entry.second->gpuMemory() + entry.second->cpuMemory();
+
+		while(used > budget) {
+			Map* victim = nullptr;
+			unsigned long long victimUse = 0;
+			for(const auto& entry : manager.maps) {
+				if(entry.second.use_count() > 1 || !entry.second->hasBuffers()) continue;
+
+				const auto lastUse = manager.mapLastUse[entry.first];
+				if(!victim || lastUse < victimUse) {
+					victim = entry.second.get();
+					victimUse = lastUse;
+				}
+			}
+			if(!victim) break;
+
+			const auto before = victim->gpuMemory() + victim->cpuMemory();
+			victim->releaseBuffers();
+			used -= before - (victim->gpuMemory() + victim->cpuMemory());
+		}
+	}
+
+	if(const auto budget = MemoryBudget::getBudget(MemoryCategory::SoundBuffers)) {
+		if(SoundEngine::exists())
+			SoundEngine::get().evictBuffers(budget);
+	}
+}
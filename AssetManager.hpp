@@ -1,10 +1,17 @@
 #pragma once
+#include <cassert>
 #include <string>
+#include <cstdint>
 #include <unordered_map>
+#include <unordered_set>
 #include "Tools/json.hpp"
 #include "Graphics/Spritesheet.hpp"
 #include "World/TileSet.hpp"
 #include "Save.hpp"
+#include "AssetPack.hpp"
+#include "AssetHandle.hpp"
+#include "HotReload.hpp"
+#include "MemoryBudget.hpp"
 
 class Map;
 
@@ -16,19 +23,49 @@ private:
 	std::unordered_map<std::string, Spritesheet> characters;
 	std::unordered_map<std::string, nlohmann::json> config;
 	std::unordered_map<std::string, sf::Font> fonts;
+	std::unordered_map<std::string, std::vector<char>> fontData;	//  sf::Font czyta glify leniwie, więc plik trzymamy w pamięci
 	std::unordered_map<std::string, std::shared_ptr<Map>> maps;
+	std::unordered_map<std::string, unsigned long long> mapLastUse;	//  do zwalniania najdawniej używanych map
+	unsigned long long mapClock {0};
+
+	//  Tablice zasobów dla uchwytów - wskaźniki na elementy powyższych hashmap
+	//  (węzły unordered_map nie zmieniają adresu, więc wskaźniki pozostają ważne)
+	std::vector<const Spritesheet*> textureSlots;
+	std::vector<const sf::Font*> fontSlots;
+	std::vector<const nlohmann::json*> jsonSlots;
+
+	template<class Handle, class T>
+	static Handle slotFor(std::vector<const T*>& slots, const T& resource) {
+		for(std::uint32_t i = 0; i < slots.size(); ++i)
+			if(slots[i] == &resource) return Handle{i};
+		slots.push_back(&resource);
+		return Handle{(std::uint32_t)(slots.size() - 1)};
+	}
 
-	Spritesheet itemset;
+	//  Paczka zasobów - jeśli otwarta, wszystkie zasoby (poza zapisem gry) czytane są z niej
+	AssetPack pack;
 
 	nlohmann::json savefile;
 
+	//  Glify zrasteryzowane do tej pory, dla każdej czcionki (klucz: glyphKey)
+	std::unordered_map<const sf::Font*, std::unordered_set<std::uint64_t>> glyphsSeen;
+	unsigned glyphMisses {0};
+
 	bool addSpritesheet(const std::string& resourcePath, std::unordered_map<std::string, Spritesheet>& map, Vec2u (*partitioner)(Vec2u textureSize) = nullptr);
+	bool addSpritesheet(const std::string& resourcePath, const sf::Image& image, std::unordered_map<std::string, Spritesheet>& map, Vec2u (*partitioner)(Vec2u textureSize) = nullptr);
 	bool addJsonFile(const std::string& resourcePath);
 	bool addFont(const std::string& resourcePath);
 	bool addMap(const std::string& resourcePath);
 	bool loadSavefile(const std::string& resourcePath);
+	bool readResource(const std::string& resourcePath, std::string& contents) const;
+	AssetPack::Resource findPacked(const std::string& resourcePath) const;
+	std::vector<std::string> listResources(const std::string& directory) const;
+	void warmGlyphs();
+
+	static std::uint64_t glyphKey(std::uint32_t codePoint, unsigned characterSize, bool bold, float outline);
 
 	static std::string getFilenameFromPath(const std::string& path);
+	static std::vector<std::string> sortedNames(const std::unordered_map<std::string, Spritesheet>& map);
 public:
 	static AssetManager& get() {
 		static AssetManager manager;
@@ -80,27 +117,75 @@ public:
 		return get().fonts[name];
 	}
 
-	static std::shared_ptr<Map> getMap(const std::string& name) {
-		if(get().maps.find(name) == get().maps.end()) {
-			std::cerr << "Map '" << name << "' does not exist!\n";
-			throw std::runtime_error("Requested non-existant map '" + name + "'");
-		}
+	/*
+	 *  Rozwiązywanie nazw do uchwytów - wołane przy ładowaniu/inicjalizacji,
+	 *  w pętli gry należy korzystać już tylko z uchwytów
+	 */
+	static TextureHandle findCharacter(const std::string& name) {
+		return slotFor<TextureHandle>(get().textureSlots, getCharacter(name));
+	}
+
+	static TextureHandle findTileset(const std::string& name) {
+		return slotFor<TextureHandle>(get().textureSlots, getTileset(name));
+	}
+
+	static TextureHandle findUI(const std::string& name) {
+		return slotFor<TextureHandle>(get().textureSlots, getUI(name));
+	}
+
+	static FontHandle findFont(const std::string& name) {
+		return slotFor<FontHandle>(get().fontSlots, getFont(name));
+	}
+
+	static JsonHandle findJSON(const std::string& name) {
+		return slotFor<JsonHandle>(get().jsonSlots, getJSON(name));
+	}
+
+	static const Spritesheet& getSpritesheet(TextureHandle handle) {
+		assert(handle.index < get().textureSlots.size());
+		return *get().textureSlots[handle.index];
+	}
 
-		return get().maps[name];
+	static const sf::Font& getFont(FontHandle handle) {
+		assert(handle.index < get().fontSlots.size());
+		return *get().fontSlots[handle.index];
 	}
 
-	static const std::unordered_map<std::string, Spritesheet> getAllTilesets(){
+	static const nlohmann::json& getJSON(JsonHandle handle) {
+		assert(handle.index < get().jsonSlots.size());
+		return *get().jsonSlots[handle.index];
+	}
+
+	static std::shared_ptr<Map> getMap(const std::string& name);
+
+	/*
+	 *  Wyliczanie spritesheetów bez kopiowania - zwracane są referencje na wewnętrzne hashmapy,
+	 *  a wersje *Names() zwracają same nazwy, posortowane (np. do list wyboru w edytorze)
+	 */
+	static const std::unordered_map<std::string, Spritesheet>& getAllTilesets(){
 		return get().tilesets;
 	}
 
-	static const std::unordered_map<std::string, Spritesheet> getAllCharacters(){
+	static const std::unordered_map<std::string, Spritesheet>& getAllCharacters(){
 		return get().characters;
 	}
 
-	static const std::unordered_map<std::string, Spritesheet> getAllUI(){
+	static const std::unordered_map<std::string, Spritesheet>& getAllUI(){
 		return get().UI;
 	}
 
+	static std::vector<std::string> getTilesetNames() {
+		return sortedNames(get().tilesets);
+	}
+
+	static std::vector<std::string> getCharacterNames() {
+		return sortedNames(get().characters);
+	}
+
+	static std::vector<std::string> getUINames() {
+		return sortedNames(get().UI);
+	}
+
 	static std::unordered_map<std::string, std::shared_ptr<Map>>& getAllMaps() {
 		return get().maps;
 	}
@@ -117,4 +202,47 @@ public:
 
 	void autoload();
 	static void loadMaps();
+
+	/*
+	 *  Dostęp do plików GameContent niezależnie od trybu (paczka / luźne pliki)
+	 *  Ścieżki podawane są tak jak na dysku, np. "GameContent/Script/default.lua"
+	 */
+	static bool readContent(const std::string& resourcePath, std::string& contents) {
+		return get().readResource(resourcePath, contents);
+	}
+	static AssetPack::Resource findContent(const std::string& resourcePath) {
+		return get().findPacked(resourcePath);
+	}
+	static bool usingPack() {
+		return get().pack.isOpen();
+	}
+
+	/*
+	 *  Przeładowuje w miejscu zasób zmieniony na dysku (patrz HotReload)
+	 *  Obiekty trzymające zasób zachowują do niego wskaźniki i referencje.
+	 */
+	static ReloadResult reloadAsset(const AssetChange& change);
+
+	/*
+	 *  Zużycie pamięci przez wszystkie zasoby (patrz MemoryBudget) - przechodzi po wszystkich
+	 *  zasobach i dokumentach JSON, więc nie należy wołać tego co klatkę
+	 */
+	static MemoryReport measureMemory();
+
+	/*
+	 *  Zwalnia bufory nieużywanych map i dźwięków, gdy przekraczają swoje limity
+	 */
+	static void enforceMemoryBudget();
+
+	/*
+	 *  Instrumentacja cache glifów - zlicza znaki, które nie zostały zrasteryzowane podczas
+	 *  ładowania (warmGlyphs) i zostaną zbudowane dopiero w trakcie gry. Wołana przy składaniu
+	 *  tekstu, nie przy rysowaniu; bez RPG_PROFILING nic nie robi.
+	 */
+#ifdef RPG_PROFILING
+	static void trackGlyphs(const sf::Text& text);
+#else
+	static void trackGlyphs(const sf::Text&) { }
+#endif
+	static unsigned getGlyphMisses() { return get().glyphMisses; }
 };
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "AssetPack.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(AssetPack::Header) == 16, "AssetPack::Header layout changed");
+static_assert(sizeof(AssetPack::Entry) == 40, "AssetPack::Entry layout changed");
+
+AssetPack::~AssetPack() {
+	close();
+}
+
+/*
+ *  FNV-1a - ta sama funkcja używana jest przez narzędzie budujące paczkę
+ */
+std::uint64_t AssetPack::hash(const std::string& path) {
+	std::uint64_t h = 14695981039346656037ull;
+	for(unsigned char c : path) {
+		h ^= c;
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+bool AssetPack::open(const std::string& path) {
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(Header)) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(!view) {
+		CloseHandle(file);
+		return false;
+	}
+	mapping = static_cast<const char*>(MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0));
+	if(!mapping) {
+		CloseHandle(view);
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle = file;
+	mappingHandle = view;
+	mappingSize = (std::size_t)size.QuadPart;
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0) return false;
+
+	struct stat info;
+	if(fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if(view == MAP_FAILED) return false;
+
+	mapping = static_cast<const char*>(view);
+	mappingSize = info.st_size;
+#endif
+
+	//  Walidacja nagłówka i indeksu - dalej dostęp do danych nie sprawdza już granic
+	const bool valid = std::memcmp(header()->magic, magic, sizeof(magic)) == 0 &&
+	                   header()->version == version &&
+	                   sizeof(Header) + (std::size_t)header()->entryCount * sizeof(Entry) + header()->namesSize <= mappingSize &&
+	                   std::all_of(entries(), entries() + header()->entryCount, [this](const Entry& entry) {
+		                   return entry.offset + entry.size <= mappingSize &&
+		                          (std::size_t)entry.nameOffset + entry.nameSize <= header()->namesSize;
+	                   });
+	if(!valid) {
+		std::cerr << "AssetPack::open()/ '" << path << "' is not a valid asset pack (version " << version << ")\n";
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void AssetPack::close() {
+	if(!mapping) return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(mapping);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+	mappingHandle = fileHandle = nullptr;
+#else
+	munmap(const_cast<char*>(mapping), mappingSize);
+#endif
+	mapping = nullptr;
+	mappingSize = 0;
+}
+
+AssetPack::Resource AssetPack::find(const std::string& path) const {
+	if(!mapping) return {};
+
+	const auto h = hash(path);
+	const Entry* begin = entries();
+	const Entry* end = begin + header()->entryCount;
+	auto it = std::lower_bound(begin, end, h, [](const Entry& entry, std::uint64_t value) {
+		return entry.hash < value;
+	});
+
+	//  Kolizje hashy są rozstrzygane porównaniem pełnej ścieżki
+	for(; it != end && it->hash == h; ++it) {
+		if(it->nameSize == path.size() && std::memcmp(names() + it->nameOffset, path.data(), path.size()) == 0)
+			return Resource{mapping + it->offset, (std::size_t)it->size, it->kind};
+	}
+	return {};
+}
+
+std::vector<std::string> AssetPack::list(const std::string& directory) const {
+	std::vector<std::string> result;
+	if(!mapping) return result;
+
+	for(auto* entry = entries(); entry != entries() + header()->entryCount; ++entry) {
+		auto name = entryName(*entry);
+		if(name.size() > directory.size() && name.compare(0, directory.size(), directory) == 0 &&
+		   name.find('/', directory.size()) == std::string::npos)
+			result.push_back(std::move(name));
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ *      AssetPack - cała zawartość GameContent w jednym pliku
+ *  Plik budowany jest narzędziem RPGPack (Tools/PackBuilder.cpp) i mapowany do pamięci w całości,
+ *  więc odczyt zasobu to jedynie wyszukanie wpisu w indeksie - bez otwierania plików i skanowania
+ *  katalogów. Obrazy są w paczce już zdekodowane (RGBA), reszta plików zapisywana jest bez zmian.
+ *
+ *  Układ pliku:
+ *      Header
+ *      Entry[entryCount]   - posortowane po hashu ścieżki
+ *      nazwy wpisów        - ścieżki względem GameContent, np. "Tilesets/forest.png"
+ *      dane wpisów         - wyrównane do 8 bajtów
+ */
+class AssetPack {
+public:
+	enum class Kind : std::uint32_t {
+		Blob = 0,
+		Image = 1	//  [u32 szerokość][u32 wysokość][piksele RGBA]
+	};
+
+	struct Header {
+		char magic[4];
+		std::uint16_t version;
+		std::uint16_t reserved;
+		std::uint32_t entryCount;
+		std::uint32_t namesSize;
+	};
+
+	struct Entry {
+		std::uint64_t hash;
+		std::uint64_t offset;
+		std::uint64_t size;
+		std::uint32_t nameOffset;
+		std::uint32_t nameSize;
+		Kind kind;
+		std::uint32_t reserved;
+	};
+
+	struct Resource {
+		const char* data {nullptr};
+		std::size_t size {0};
+		Kind kind {Kind::Blob};
+
+		explicit operator bool() const { return data != nullptr; }
+	};
+
+	static constexpr char magic[4] = {'R', 'P', 'G', 'P'};
+	static constexpr std::uint16_t version = 1;
+	static constexpr const char* defaultPath = "GameContent.pack";
+
+	AssetPack() = default;
+	AssetPack(const AssetPack&) = delete;
+	AssetPack& operator=(const AssetPack&) = delete;
+	~AssetPack();
+
+	bool open(const std::string& path);
+	void close();
+	bool isOpen() const { return mapping != nullptr; }
+
+	Resource find(const std::string& path) const;
+
+	/*
+	 *  Ścieżki wszystkich wpisów w danym katalogu paczki (np. "Tilesets/"), bez podkatalogów
+	 */
+	std::vector<std::string> list(const std::string& directory) const;
+
+	static std::uint64_t hash(const std::string& path);
+private:
+	const char* mapping {nullptr};
+	std::size_t mappingSize {0};
+#ifdef _WIN32
+	void* fileHandle {nullptr};
+	void* mappingHandle {nullptr};
+#endif
+
+	const Header* header() const { return reinterpret_cast<const Header*>(mapping); }
+	const Entry* entries() const { return reinterpret_cast<const Entry*>(mapping + sizeof(Header)); }
+	const char* names() const { return mapping + sizeof(Header) + header()->entryCount * sizeof(Entry); }
+	std::string entryName(const Entry& entry) const { return std::string(names() + entry.nameOffset, entry.nameSize); }
+};
@@ -2,6 +2,7 @@
 #include "BattleSystem/BattleEngine.hpp"
 #include "World/WorldManager.hpp"
 #include "Entity/NPC.hpp"
+#include "Profiler.hpp"
 
 BattleEngine* BattleEngine::instance {nullptr};
 static Script* caller {nullptr};
@@ -9,7 +10,14 @@ static Script* caller {nullptr};
 void BattleEngine::Init() {
 
 	background = AssetManager::getUI("battle_back").getSprite();
-	interface = AssetManager::getUI("windowskin").getSprite();
+	const auto& windowskin = AssetManager::getUI("windowskin").getTexture();
+	backdrop.setTexture(windowskin);
+	backdrop.setStyle(NineSlice::rawStyle(sf::IntRect(128, 0, 64, 64)));
+
+	auto frameStyle = NineSlice::windowStyle();
+	frameStyle.background = sf::IntRect();
+	battleFrame.setTexture(windowskin);
+	battleFrame.setStyle(frameStyle);
 
 	playerWindow.Init(sf::Vector2f(0, 0), sf::Vector2f(0, 0));
 	enemyWindow.Init(sf::Vector2f(0, 0), sf::Vector2f(0, 0));
@@ -49,6 +57,7 @@ void BattleEngine::Init() {
 }
 
 void BattleEngine::Draw(sf::RenderTarget& target) {
+	PROFILE_SCOPE("Battle draw");
 	DrawBackground(target);
 	DrawBattleBack(target);
 	DrawInterface(target);
@@ -59,11 +68,8 @@ void BattleEngine::Draw(sf::RenderTarget& target) {
 
 void BattleEngine::DrawBackground(sf::RenderTarget& target) {
 	target.clear(sf::Color(255,255,255));
-	interface.setTextureRect(sf::Rect(128, 0, 64, 64));
-	sf::Vector2f scale = { (float)(target.getSize().x / 64.0), (float)(target.getSize().y / 64.0) };
-	interface.setScale(scale);
-	interface.setPosition(sf::Vector2f(0, 0));
-	target.draw(interface);
+	backdrop.setSize(sf::Vector2f(target.getSize()));
+	target.draw(backdrop);
 }
 
 void BattleEngine::DrawBattleBack(sf::RenderTarget& target) {
@@ -73,59 +79,22 @@ void BattleEngine::DrawBattleBack(sf::RenderTarget& target) {
 	target.draw(background);
 
 	if (target.getSize().x > 1200 and target.getSize().y > 650) {
-		interface.setScale(1.0, 1.0);
-		//Top - Left Corner
-		interface.setTextureRect(sf::IntRect(0, 0, 16, 16));
-		interface.setPosition(battleBackPos);
-		target.draw(interface);
-		//Top Frame
-		interface.setTextureRect(sf::IntRect(16, 0, 96, 16));
-		interface.setScale((size.x - 32) / 96.0, 1.0);
-		interface.setPosition(battleBackPos + sf::Vector2f(16, 0));
-		target.draw(interface);
-		//Top - Right Corner
-		interface.setScale(1.0, 1.0);
-		interface.setTextureRect(sf::IntRect(112, 0, 16, 16));
-		interface.setPosition(battleBackPos + sf::Vector2f(size.x - 16, 0));
-		target.draw(interface);
-		//Left Frame
-		interface.setTextureRect(sf::IntRect(0, 16, 16, 96));
-		interface.setScale(1.0, (size.y - 32) / 96.0);
-		interface.setPosition(battleBackPos + sf::Vector2f(0, 16));
-		target.draw(interface);
-		//Right Frame
-		interface.setTextureRect(sf::IntRect(112, 16, 16, 96));
-		interface.setPosition(battleBackPos + sf::Vector2f(size.x - 16, 16));
-		target.draw(interface);
-		//Bottom - Left Corner
-		interface.setScale(1.0, 1.0);
-		interface.setTextureRect(sf::IntRect(0, 112, 16, 16));
-		interface.setPosition(battleBackPos + sf::Vector2f(0, size.y - 16));
-		target.draw(interface);
-		//Bottom - Right Corner
-		interface.setTextureRect(sf::IntRect(112, 112, 16, 16));
-		interface.setPosition(battleBackPos + size - sf::Vector2f(16, 16));
-		target.draw(interface);
-		//Bottom Frame
-		interface.setTextureRect(sf::IntRect(16, 112, 96, 16));
-		interface.setScale((size.x - 32) / 96.0, 1.0);
-		interface.setPosition(battleBackPos + sf::Vector2f(16, size.y - 16));
-		target.draw(interface);
-
-		interface.setScale(1.0, 1.0);
+		battleFrame.setPosition(battleBackPos);
+		battleFrame.setSize(size);
+		target.draw(battleFrame);
 	}
 	DrawPlayer(target, battleBackPos);
 	DrawEnemy(target, battleBackPos);
 }
 
 void BattleEngine::DrawPlayer(sf::RenderTarget& target, sf::Vector2f offset) {
-	sf::Sprite toDraw = AssetManager::getCharacter("playersprite").getSprite(10);
+	sf::Sprite toDraw = AssetManager::getSpritesheet(player_sheet).getSprite(10);
 	toDraw.setPosition(offset + sf::Vector2f{ 227,272 });
 	target.draw(toDraw);
 }
 
 void BattleEngine::DrawEnemy(sf::RenderTarget& target, sf::Vector2f offset) {
-	sf::Sprite toDraw = AssetManager::getCharacter(dynamic_cast<NPC*>(enemy)->getSpritesheetName()).getSprite(6);
+	sf::Sprite toDraw = AssetManager::getSpritesheet(enemy_sheet).getSprite(6);
 	toDraw.setPosition(offset + sf::Vector2f{ 517,272 });
 	target.draw(toDraw);
 }
@@ -155,7 +124,7 @@ void BattleEngine::DrawButtons(sf::RenderTarget& target, sf::Vector2f offset) {
 		buttons[i].SetPosition(offset - sf::Vector2f(0, selfPosition.y * j--));
 	}
 
-	if (player.getStatistics()["MP"] < 25) {
+	if (player.getStat("MP") < 25) {
 		buttons[1].SetColor(sf::Color(38, 38, 38));
 	}
 	else {
@@ -175,7 +144,7 @@ void BattleEngine::ProcessKey(sf::Event::KeyEvent key) {
 void BattleEngine::Call() {
 	//Obs�uga Przycisk�w
 	if (focus == 0) current = QUICK;
-	if (focus == 1 and player.getStatistics()["MP"] > 25) current = HEAL;
+	if (focus == 1 and player.getStat("MP") > 25) current = HEAL;
 	if (focus == 2) current = DEFEND;
 	//if (focus == 3) current = ITEM;
 	if (focus == 3) current = FLEE;
@@ -201,14 +170,17 @@ bool BattleEngine::InitBattle(Actor* hao, Script* _caller) {
 	active = true;
 	current = NOTYET;
 
-	player_sprit = AssetManager::getCharacter("playersprite").getSprite(0);
-	enemy_sprit = AssetManager::getCharacter(dynamic_cast<NPC*>(enemy)->getSpritesheetName()).getSprite(0);
+	player_sheet = AssetManager::findCharacter("playersprite");
+	enemy_sheet = AssetManager::findCharacter(dynamic_cast<NPC*>(enemy)->getSpritesheetName());
+	player_sprit = AssetManager::getSpritesheet(player_sheet).getSprite(0);
+	enemy_sprit = AssetManager::getSpritesheet(enemy_sheet).getSprite(0);
 	queueWindow.Init(sf::Vector2f(100, 0), sf::Vector2f(496, 64), player_sprit, enemy_sprit);
 
 	return true;
 }
 
 BattleState BattleEngine::updateBattle() {
+	PROFILE_SCOPE("Battle update");
 	return ProcessTurn();
 }
 
@@ -229,11 +201,11 @@ BattleState BattleEngine::ProcessTurn() {
 	}
 
 	if(active) {
-		if (player.getStatistics()["HP"] <= 0) {
+		if (player.getStat("HP") <= 0) {
 			Defeat();
 			return BattleState::Defeat;
 		} 
-		if (enemy->getStatistics()["HP"] <= 0) {
+		if (enemy->getStat("HP") <= 0) {
 			Victory();
 			return BattleState::Victory;
 		}
@@ -270,23 +242,23 @@ void BattleEngine::PlayerTurn(Action action) {
 void BattleEngine::QuickAtack(Actor& source, Actor& target, bool source_is_player) {
 	std::uniform_int_distribution<int> doge(0, 100);
 
-	if (doge(mt) > source.getStatistics()["Dodge"]) {
+	if (doge(mt) > source.getStat("Dodge")) {
 
-		int melee = source.getStatistics()["Attack"];
-		int defence = target.getStatistics()["Armor"];
+		int melee = source.getStat("Attack");
+		int defence = target.getStat("Armor");
 
 		if (source_is_player) {
 			for (unsigned j = 0; j < (unsigned)EquipmentSlot::_DummyEnd; ++j) {
-				auto item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
-				if (item == nullptr) continue;
-				melee += item->getStat("Attack");
+				const auto& item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
+				if (item.empty()) continue;
+				melee += item.getStat(ItemStat::Attack);
 			}
 		}
 		else {
 			for (unsigned j = 0; j < (unsigned)EquipmentSlot::_DummyEnd; ++j) {
-				auto item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
-				if (item == nullptr) continue;
-				defence += item->getStat("Armor");
+				const auto& item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
+				if (item.empty()) continue;
+				defence += item.getStat(ItemStat::Armor);
 			}
 		}
 
@@ -301,29 +273,29 @@ void BattleEngine::QuickAtack(Actor& source, Actor& target, bool source_is_playe
 		}
 
 		std::uniform_int_distribution<int> crit(0, 100);
-		if (crit(mt) < source.getStatistics()["Crit"]) {
+		if (crit(mt) < source.getStat("Crit")) {
 			damage *= 2.0;
 		}
 
-		int fire = source.getStatistics()["Fire"];
-		int water = source.getStatistics()["Water"];
-		int thunder = source.getStatistics()["Lightning"];
-		int resistance = target.getStatistics()["Resistance"];
+		int fire = source.getStat("Fire");
+		int water = source.getStat("Water");
+		int thunder = source.getStat("Lightning");
+		int resistance = target.getStat("Resistance");
 
 		if (source_is_player) {
 			for (unsigned j = 0; j < (unsigned)EquipmentSlot::_DummyEnd; ++j) {
-				auto item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
-				if (item == nullptr) continue;
-				fire += item->getStat("Fire");
-				water += item->getStat("Water");
-				thunder += item->getStat("Lightning");
+				const auto& item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
+				if (item.empty()) continue;
+				fire += item.getStat(ItemStat::Fire);
+				water += item.getStat(ItemStat::Water);
+				thunder += item.getStat(ItemStat::Lightning);
 			}
 		}
 		else {
 			for (unsigned j = 0; j < (unsigned)EquipmentSlot::_DummyEnd; ++j) {
-				auto item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
-				if (item == nullptr) continue;
-				defence += item->getStat("Resistance");
+				const auto& item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
+				if (item.empty()) continue;
+				defence += item.getStat(ItemStat::Resistance);
 			}
 		}
 
@@ -336,25 +308,32 @@ void BattleEngine::QuickAtack(Actor& source, Actor& target, bool source_is_playe
 		}
 		else magic_damage = water + fire_dmg(mt) + thunder_dmg(mt) * (resistance / 100.0);
 
-		target.getStatistics()["HP"] -= (magic_damage + damage);
+		int targetHP = target.getStat("HP") - (magic_damage + damage);
+		int sourceHP = source.getStat("HP");
 		if (defending == true) {
-			source.getStatistics()["HP"] -= (source.getStatistics()["Attack"] * 0.15);
+			sourceHP -= (source.getStat("Attack") * 0.15);
 			defending = false;
 		}
 
-		if (target.getStatistics()["HP"] > target.getStatistics()["MaxHP"]) target.getStatistics()["HP"] = target.getStatistics()["MaxHP"];
-		if (target.getStatistics()["HP"] < 0) target.getStatistics()["HP"] = 0;
+		if (targetHP > target.getStat("MaxHP")) targetHP = target.getStat("MaxHP");
+		if (targetHP < 0) targetHP = 0;
+		target.setStat("HP", targetHP);
 
-		if (source.getStatistics()["HP"] > source.getStatistics()["MaxHP"]) source.getStatistics()["HP"] = source.getStatistics()["MaxHP"];
-		if (source.getStatistics()["HP"] < 0) source.getStatistics()["HP"] = 0;
+		if (sourceHP > source.getStat("MaxHP")) sourceHP = source.getStat("MaxHP");
+		if (sourceHP < 0) sourceHP = 0;
+		source.setStat("HP", sourceHP);
 	}
 }
 
 void BattleEngine::Heal(Actor& source) {
-	source.getStatistics()["HP"] += (source.getStatistics()["HP"] * 0.15) + (source.getStatistics()["Water"] * 0.5);
-	if (source.getStatistics()["HP"] > source.getStatistics()["MaxHP"]) source.getStatistics()["HP"] = source.getStatistics()["MaxHP"];
-	source.getStatistics()["MP"] -= 25;
-	if (source.getStatistics()["MP"] < 0 ) source.getStatistics()["MP"] = 0;
+	int hp = source.getStat("HP");
+	hp += (hp * 0.15) + (source.getStat("Water") * 0.5);
+	if (hp > source.getStat("MaxHP")) hp = source.getStat("MaxHP");
+	source.setStat("HP", hp);
+
+	int mp = source.getStat("MP") - 25;
+	if (mp < 0 ) mp = 0;
+	source.setStat("MP", mp);
 }
 
 void BattleEngine::Defend(Actor& source) {
@@ -367,8 +346,8 @@ void BattleEngine::EnemyTurn() {
 
 void BattleEngine::Enqueue() {
 	int playerAS, ememyAS;
-	playerAS = 3;	//player.getStatistics()["AttackSpeed"];
-	ememyAS = 2;	//enemy->getStatistics()["AttackSpeed"];
+	playerAS = 3;	//player.getStat("AttackSpeed");
+	ememyAS = 2;	//enemy->getStat("AttackSpeed");
 
 	double playerChance = 1.0 * (turnCouner % 2);
 	double ASmodifier = (playerAS - ememyAS) / 33.0;
@@ -396,9 +375,10 @@ void BattleEngine::Enqueue() {
 }
 
 void BattleEngine::Victory() {
-	std::uniform_int_distribution<int> gold((enemy->getStatistics()["MaxHP"]/75), (enemy->getStatistics()["MaxHP"] / 50));
-	player.GainEXP(enemy->getStatistics()["MaxHP"] / (player.getPlayerInfo()["lvl"]));
+	std::uniform_int_distribution<int> gold((enemy->getStat("MaxHP")/75), (enemy->getStat("MaxHP") / 50));
+	player.GainEXP(enemy->getStat("MaxHP") / (player.getInfo("lvl")));
 	player.GainGold(gold(mt));
+	WorldManager::shouldAutosave();
 	EndBattle();
 }
 
@@ -6,6 +6,7 @@
 #include "PlayerUI.hpp"
 #include "EnemyUI.hpp"
 #include "BattleSystem/QueueUI.hpp"
+#include "Interface/Components/NineSlice.hpp"
 #include <random> 
 
 enum Action {
@@ -32,7 +33,8 @@ private:
 	Actor* enemy;
 	Player& player;
 	std::queue<Turn> queue;
-	sf::Sprite interface;
+	NineSlice backdrop;		//tło całego ekranu walki
+	NineSlice battleFrame;	//ramka wokół areny
 	sf::Sprite background;
 	int turnCouner;
 	PlayerUI playerWindow;
@@ -43,6 +45,7 @@ private:
 	int focus;			//current focus
 	std::vector<OptionWindow> buttons;
 	sf::Sprite player_sprit, enemy_sprit;
+	TextureHandle player_sheet, enemy_sheet;
 	std::mt19937 mt;
 	Action current;
 public:
@@ -53,6 +56,8 @@ public:
 	}
 
 	void Init();
+	//  Stałe ziarno losowania - powtarzalne walki (benchmarki)
+	void Seed(std::mt19937::result_type seed) { mt.seed(seed); }
 	void Draw(sf::RenderTarget&);
 	void DrawBackground(sf::RenderTarget&);
 	void DrawBattleBack(sf::RenderTarget&);
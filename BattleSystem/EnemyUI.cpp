@@ -19,6 +19,10 @@ void EnemyUI::DrawSelf(sf::RenderTarget& target) {
 void EnemyUI::SelfInit() {
 	//Getting sprites
 	stat_icons.setTexture(AssetManager::getUI("stat_icons").getTexture());	//stat_icons
+
+	//Glyph tracking - texts are rebuilt every frame, so their character set is registered once here
+	AssetManager::trackGlyphs(sf::Text("Przeciwnik", font, 19));
+	AssetManager::trackGlyphs(sf::Text("0123456789-/%", font, 16));
 }
 
 void EnemyUI::DrawIcon(sf::RenderTarget& target, sf::Sprite& object, int index, sf::Vector2f position, sf::Vector2f size) {
@@ -41,16 +45,16 @@ void EnemyUI::DrawPlayerInfo(sf::RenderTarget& target, sf::Vector2f offset, int
 	//HP
 	offset += sf::Vector2f(0, font_size + 4);
 	DrawIcon(target, stat_icons, 0, offset, sf::Vector2f(32, 32));
-	int maxhp = enemy->getStatistics()["MaxHP"];
-	int hp = enemy->getStatistics()["HP"];
+	int maxhp = enemy->getStat("MaxHP");
+	int hp = enemy->getStat("HP");
 	DrawLine(target, offset + sf::Vector2f(28, 8), ParseText(hp, maxhp, font_size - 2, "", "/"), sf::Color::Red);
 	DrawBar(target, offset + sf::Vector2f(0, 28), hp, maxhp, sf::Vector2f(size.x - 32, 4), sf::Color::Red);
 
 	//MP
 	offset += sf::Vector2f(0, 32);
 	DrawIcon(target, stat_icons, 1, offset, sf::Vector2f(32, 32));
-	int maxmp = enemy->getStatistics()["MaxMP"];
-	int mp = enemy->getStatistics()["MP"];
+	int maxmp = enemy->getStat("MaxMP");
+	int mp = enemy->getStat("MP");
 	DrawLine(target, offset + sf::Vector2f(28, 8), ParseText(mp, maxmp, font_size - 2, "", "/"), sf::Color::Blue);
 	DrawBar(target, offset + sf::Vector2f(0, 28), mp, maxmp, sf::Vector2f(size.x - 32, 4), sf::Color::Blue);
 }
@@ -78,7 +82,7 @@ void EnemyUI::DrawStatistics(sf::RenderTarget& target, sf::Vector2f position, in
 		DrawIcon(target, stat_icons, i - 2, position + sf::Vector2f(2, 2), sf::Vector2f(32, 32));
 
 		//Get Base statistic
-		double middle = enemy->getStatistics()[statIndex[i]];
+		double middle = enemy->getStat(statIndex[i]);
 
 		std::string sufix = "";						//Default suffix
 		int ceil = int(middle + (middle * 0.15));	//ceil of middle
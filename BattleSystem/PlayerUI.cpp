@@ -1,7 +1,7 @@
 #include "PlayerUI.hpp"
 
 PlayerUI::PlayerUI(Player& entity)
-	: player(entity), statistics(entity.getStatistics()), player_info(entity.getPlayerInfo()), font(AssetManager::getFont("VCR_OSD_MONO"))
+	: player(entity), font(AssetManager::getFont("VCR_OSD_MONO"))
 {
 
 }
@@ -15,6 +15,12 @@ void PlayerUI::DrawSelf(sf::RenderTarget& target) {
 void PlayerUI::SelfInit() {
 	//Getting sprites
 	stat_icons.setTexture(AssetManager::getUI("stat_icons").getTexture());	//stat_icons
+
+	//Glyph tracking - texts are rebuilt every frame, so their character set is registered once here
+	const std::string values = "0123456789-/%";
+	AssetManager::trackGlyphs(sf::Text(player.getName(), font, 19));
+	AssetManager::trackGlyphs(sf::Text("level " + values, font, 16));
+	AssetManager::trackGlyphs(sf::Text("EXP: " + values, font, 14));
 }
 
 void PlayerUI::DrawIcon(sf::RenderTarget& target, sf::Sprite& object, int index, sf::Vector2f position, sf::Vector2f size) {
@@ -33,31 +39,31 @@ void PlayerUI::DrawPlayerInfo(sf::RenderTarget& target, sf::Vector2f offset, int
 
 	//Level
 	offset += sf::Vector2f(0, font_size + 4);
-	DrawLine(target, offset, ParseText(player_info["lvl"], font_size - 2, "level "), sf::Color::Green);
+	DrawLine(target, offset, ParseText(player.getInfo("lvl"), font_size - 2, "level "), sf::Color::Green);
 
 	//HP
 	offset += sf::Vector2f(0, font_size + 4);
 	DrawIcon(target, stat_icons, 0, offset, sf::Vector2f(32, 32));
-	DrawLine(target, offset + sf::Vector2f(28, 8), ParseText(statistics["HP"], statistics["MaxHP"], font_size - 2, "", "/"), sf::Color::Red);
-	DrawBar(target, offset + sf::Vector2f(0, 28), statistics["HP"], statistics["MaxHP"], sf::Vector2f(size.x - 32, 4), sf::Color::Red);
+	DrawLine(target, offset + sf::Vector2f(28, 8), ParseText(player.getStat("HP"), player.getStat("MaxHP"), font_size - 2, "", "/"), sf::Color::Red);
+	DrawBar(target, offset + sf::Vector2f(0, 28), player.getStat("HP"), player.getStat("MaxHP"), sf::Vector2f(size.x - 32, 4), sf::Color::Red);
 
 	//MP
 	offset += sf::Vector2f(0, 32);
 	DrawIcon(target, stat_icons, 1, offset, sf::Vector2f(32, 32));
-	DrawLine(target, offset + sf::Vector2f(28, 8), ParseText(statistics["MP"], statistics["MaxMP"], font_size - 2, "", "/"), sf::Color::Blue);
-	DrawBar(target, offset + sf::Vector2f(0, 28), statistics["MP"], statistics["MaxMP"], sf::Vector2f(size.x - 32, 4), sf::Color::Blue);
+	DrawLine(target, offset + sf::Vector2f(28, 8), ParseText(player.getStat("MP"), player.getStat("MaxMP"), font_size - 2, "", "/"), sf::Color::Blue);
+	DrawBar(target, offset + sf::Vector2f(0, 28), player.getStat("MP"), player.getStat("MaxMP"), sf::Vector2f(size.x - 32, 4), sf::Color::Blue);
 
 	//EXP
 	offset += sf::Vector2f(0, 40);
-	DrawBar(target, offset, player_info["current"], player_info["next"], sf::Vector2f(size.x - 32, 4), sf::Color::Yellow);
-	DrawLine(target, offset + sf::Vector2f(0, 3), ParseText(player_info["current"], player_info["next"], font_size - 4, "EXP: ", "/"), sf::Color::White);
+	DrawBar(target, offset, player.getInfo("current"), player.getInfo("next"), sf::Vector2f(size.x - 32, 4), sf::Color::Yellow);
+	DrawLine(target, offset + sf::Vector2f(0, 3), ParseText(player.getInfo("current"), player.getInfo("next"), font_size - 4, "EXP: ", "/"), sf::Color::White);
 }
 
 void PlayerUI::DrawStatistics(sf::RenderTarget& target, sf::Vector2f position, int font_size) {
 
 	//=============================== DATA ===============================//
 		//KEYS FOR STATISTIC MAP
-	std::vector<std::string> statIndex{ "HP","MaxHP",
+	static const std::vector<std::string> statIndex{ "HP","MaxHP",
 										"MP","MaxMP",
 										"Attack",
 										"Fire",
@@ -76,13 +82,13 @@ void PlayerUI::DrawStatistics(sf::RenderTarget& target, sf::Vector2f position, i
 		DrawIcon(target, stat_icons, i - 2, position + sf::Vector2f(2, 2), sf::Vector2f(32, 32));
 
 		//Get Base statistic
-		double middle = statistics[statIndex[i]];
+		double middle = player.getStat(statIndex[i]);
 
 		//Get all bonus statistic
 		for (unsigned j = 0; j < (unsigned)EquipmentSlot::_DummyEnd; ++j) {
-			auto item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
-			if (item == nullptr) continue;
-			middle += item->getStat(statIndex[i]);
+			const auto& item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
+			if (item.empty()) continue;
+			middle += item.getStat((ItemStat)i);
 		}
 
 		std::string sufix = "";						//Default suffix
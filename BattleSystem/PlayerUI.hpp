@@ -19,8 +19,6 @@ protected:
 
 	//PLAYER
 	Player& player;								//Player
-	std::map<std::string, int>& statistics;		//Player's statistics
-	std::map<std::string, int>& player_info;	//Player's data info
 
 	//Self Operation
 	void DrawSelf(sf::RenderTarget&)override;
@@ -0,0 +1,94 @@
+#include "BenchFixture.hpp"
+#include "World/ItemRegistry.hpp"
+
+static const std::map<std::string, int> s_player_statistics {
+	{"HP", 100}, {"MaxHP", 100},
+	{"MP", 35}, {"MaxMP", 35},
+	{"Attack", 3}, {"Fire", 0}, {"Water", 0}, {"Lightning", 0},
+	{"AttackSpeed", 2}, {"Armor", 1}, {"Resistance", 0},
+	{"Critical", 0}, {"Dodge", 0}
+};
+
+static const std::map<std::string, int> s_player_info {
+	{"lvl", 1}, {"current", 0}, {"next", 11}, {"gold", 25}
+};
+
+//  Przeciwnik dobrany tak, by walki kończyły się raz wygraną, raz przegraną
+static const std::map<std::string, int> s_enemy_statistics {
+	{"HP", 60}, {"MaxHP", 60},
+	{"MP", 20}, {"MaxMP", 20},
+	{"Attack", 5}, {"Fire", 0}, {"Water", 0}, {"Lightning", 0},
+	{"AttackSpeed", 2}, {"Armor", 1}, {"Resistance", 0},
+	{"Critical", 0}, {"Dodge", 0}
+};
+
+BenchFixture::BenchFixture(const Config& benchConfig)
+: config(benchConfig), battle(world.getPlayer()) {
+	SoundEngine::setVolume(0.0);
+	AssetManager::loadMaps();
+
+	if(config.character.empty()) {
+		const auto characters = AssetManager::getCharacterNames();
+		if(!characters.empty()) config.character = characters.front();
+	}
+
+	std::string source;
+	scriptAvailable = AssetManager::readContent("GameContent/Script/" + config.script + ".lua", source)
+	                  && AssetManager::readContent("GameContent/Script/" + config.enemyScript + ".lua", source);
+
+	mapAvailable = AssetManager::getAllMaps().count(config.map) != 0;
+	if(mapAvailable)
+		world.setCurrentMap(config.map);
+
+	for(ItemID id = 0; id < ItemRegistry::count(); ++id)
+		itemDesignators.push_back(ItemRegistry::getDefinition(id).designator);
+
+	battle.Init();
+	resetPlayer();
+}
+
+void BenchFixture::resetPlayer() {
+	auto& player = world.getPlayer();
+	for(const auto& [name, value] : s_player_statistics)
+		player.setStat(name, value);
+	for(const auto& [name, value] : s_player_info)
+		player.setInfo(name, value);
+
+	auto& inventory = player.getInventory();
+	for(unsigned i = 0; i < PlayerInventory::defaultSize; ++i)
+		inventory.deleteItem(i);
+	inventory.getEquipment().clear();
+
+	if(mapAvailable) {
+		auto& map = world.getMap();
+		player.setPosition(Vec2u(map.getWidth() / 2, map.getHeight() / 2));
+	} else {
+		player.setPosition(Vec2u(0, 0));
+	}
+}
+
+void BenchFixture::resetEnemy(NPC& enemy) {
+	for(const auto& [name, value] : s_enemy_statistics)
+		enemy.setStat(name, value);
+}
+
+std::shared_ptr<Map> BenchFixture::loadMap() {
+	auto map = Map::from_file(config.map);
+	map->bindPlayer(world.getPlayer());
+	return map;
+}
+
+std::shared_ptr<Map> BenchFixture::makeCrowdedMap(unsigned count, std::mt19937& random) {
+	const auto tilesets = AssetManager::getTilesetNames();
+	if(!mapAvailable && tilesets.empty())
+		throw std::runtime_error("No tileset available for the benchmark map");
+	const std::string tileset = mapAvailable ? world.getMap().getTilesetName() : tilesets.front();
+	const Vec2u size(64, 64);
+	auto map = Map::make_empty(size, 0, tileset);
+	map->bindPlayer(world.getPlayer());
+
+	std::uniform_int_distribution<unsigned> x(0, size.x - 1), y(0, size.y - 1);
+	for(unsigned i = 0; i < count; ++i)
+		map->addNPC(std::make_shared<NPC>(config.character, Vec2u(x(random), y(random)), config.enemyScript));
+	return map;
+}
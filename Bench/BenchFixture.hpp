@@ -0,0 +1,69 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "World/WorldManager.hpp"
+#include "Save.hpp"
+#include "Sound/SoundEngine.hpp"
+#include "BattleSystem/BattleEngine.hpp"
+#include "Entity/NPC.hpp"
+#include "Harness.hpp"
+
+/*
+ *      BenchFixture - wspólny stan gry dla benchmarków
+ *  Świat, gracz, silnik walki i dźwięk (wyciszony) bez okna - tak jak w Engine, ale bez renderowania
+ *  na ekran. Przed każdą próbką gracz wraca do stałych statystyk i pustego plecaka, a wszystkie
+ *  losowania korzystają ze stałego ziarna, więc wyniki nie zależą od zapisu gry ani od poprzednich próbek.
+ *  Zapis gry jest tylko czytany - autozapisy przy zmianie mapy są odrzucane.
+ *  Zasoby pochodzą z GameContent, jak w grze - benchmark uruchamia się z katalogu gry.
+ */
+class BenchFixture {
+public:
+	struct Config {
+		std::string map {"default"};
+		std::string character;			//  pusty - pierwszy dostępny spritesheet postaci
+		std::string script {"testscript"};
+		std::string enemyScript {"default"};
+		unsigned seed {1234};
+	};
+private:
+	//  Pierwszy składnik - zapis gry musi być wyłączony, zanim świat wczyta zasoby i przejdzie między mapami
+	struct SaveGuard {
+		SaveGuard() { SaveWriter::setDiscard(true); }
+	} saveGuard;
+	Config config;
+	SoundEngine sound;
+	WorldManager world;
+	BattleEngine battle;
+	bool mapAvailable {false};
+	bool scriptAvailable {false};
+	std::vector<std::string> itemDesignators;
+public:
+	BenchFixture(const Config& benchConfig);
+
+	const Config& getConfig() const { return config; }
+	bool hasMap() const { return mapAvailable; }
+	bool hasCharacter() const { return !config.character.empty(); }
+	bool hasScript() const { return scriptAvailable; }
+	const std::vector<std::string>& getItemDesignators() const { return itemDesignators; }
+
+	WorldManager& getWorld() { return world; }
+	Player& getPlayer() { return world.getPlayer(); }
+	BattleEngine& getBattle() { return battle; }
+
+	/*
+	 *  Stałe statystyki, pusty plecak i ekwipunek, pozycja na środku bieżącej mapy
+	 */
+	void resetPlayer();
+	static void resetEnemy(NPC& enemy);
+
+	//  Osobna kopia mapy z pliku - benchmarki nie zmieniają map trzymanych przez AssetManager
+	std::shared_ptr<Map> loadMap();
+	//  Pusta mapa z tilesetem mapy testowej i `count` NPC rozrzuconymi losowo
+	std::shared_ptr<Map> makeCrowdedMap(unsigned count, std::mt19937& random);
+};
+
+void registerMicroBenchmarks(Harness& harness, BenchFixture& fixture);
+void registerMacroBenchmarks(Harness& harness, BenchFixture& fixture);
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include "Harness.hpp"
+#include "Tools/json.hpp"
+
+struct Statistics {
+	double median {0.0};
+	double mean {0.0};
+	double min {0.0};
+	double max {0.0};
+	double stddev {0.0};
+};
+
+static Statistics summarize(std::vector<double> values) {
+	Statistics stats;
+	if(values.empty()) return stats;
+
+	std::sort(values.begin(), values.end());
+	const auto count = values.size();
+	stats.median = count % 2 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2.0;
+	stats.mean = std::accumulate(values.begin(), values.end(), 0.0) / count;
+	stats.min = values.front();
+	stats.max = values.back();
+
+	double variance = 0.0;
+	for(auto value : values)
+		variance += (value - stats.mean) * (value - stats.mean);
+	stats.stddev = std::sqrt(variance / count);
+	return stats;
+}
+
+void Harness::add(const std::string& group, const std::string& name, unsigned iterations, Function function) {
+	benchmarks.push_back(Benchmark{group, name, std::max(1u, iterations), std::move(function)});
+}
+
+void Harness::skip(const std::string& group, const std::string& name, const std::string& reason) {
+	if(!filter.empty() && name.find(filter) == std::string::npos) return;
+
+	Result result;
+	result.group = group;
+	result.name = name;
+	result.skipped = reason;
+	results.push_back(std::move(result));
+	std::cerr << "RPGBench/ Skipping " << name << ": " << reason << "\n";
+}
+
+void Harness::run() {
+	using clock = std::chrono::steady_clock;
+
+	for(auto& benchmark : benchmarks) {
+		if(!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+
+		Result result;
+		result.group = benchmark.group;
+		result.name = benchmark.name;
+		result.iterations = benchmark.iterations;
+		std::cout << "RPGBench/ Running " << benchmark.name << " (" << samples << " x " << benchmark.iterations << ")\n";
+
+		try {
+			//  Rozgrzewka - liczniki z niej są odrzucane
+			Counters warmupCounters;
+			Run warmup {benchmark.iterations, warmupCounters};
+			benchmark.function(warmup);
+
+			for(unsigned i = 0; i < samples; ++i) {
+				Counters counters;
+				Run run {benchmark.iterations, counters};
+				const auto start = clock::now();
+				benchmark.function(run);
+				const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+				result.nsPerOp.push_back(elapsed / benchmark.iterations);
+				//  Liczniki uśredniane po próbkach
+				for(auto& [key, value] : counters)
+					result.counters[key] += value / samples;
+			}
+		} catch (std::exception& ex) {
+			std::cerr << "RPGBench/ Benchmark " << benchmark.name << " failed: " << ex.what() << "\n";
+			result.nsPerOp.clear();
+			result.counters.clear();
+			result.skipped = std::string("failed: ") + ex.what();
+		}
+		results.push_back(std::move(result));
+	}
+}
+
+void Harness::printSummary() const {
+	std::printf("\n%-36s %14s %14s %14s\n", "Benchmark", "median", "min", "stddev");
+	for(auto& result : results) {
+		if(!result.skipped.empty()) {
+			std::printf("%-36s %s\n", result.name.c_str(), ("skipped (" + result.skipped + ")").c_str());
+			continue;
+		}
+
+		const auto stats = summarize(result.nsPerOp);
+		auto format = [](double ns) {
+			char buffer[32];
+			if(ns >= 1e6) std::snprintf(buffer, sizeof(buffer), "%.3f ms", ns / 1e6);
+			else if(ns >= 1e3) std::snprintf(buffer, sizeof(buffer), "%.3f us", ns / 1e3);
+			else std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+			return std::string(buffer);
+		};
+		std::printf("%-36s %14s %14s %14s\n", result.name.c_str(),
+		            format(stats.median).c_str(), format(stats.min).c_str(), format(stats.stddev).c_str());
+	}
+}
+
+/*
+ *  Wyniki w JSON - jeden obiekt na benchmark, czasy w ns na operację.
+ *  Format jest stały, żeby wyniki z różnych wersji dało się porównywać skryptem.
+ */
+bool Harness::writeJson(const std::string& path, const std::map<std::string, std::string>& config) const {
+	nlohmann::json document;
+	document["format"] = 1;
+	document["timestamp"] = (std::int64_t)std::time(nullptr);
+	document["config"] = config;
+	document["samples"] = samples;
+#ifdef NDEBUG
+	document["build"]["assertions"] = false;
+#else
+	document["build"]["assertions"] = true;
+#endif
+#ifdef RPG_PROFILING
+	document["build"]["profiling"] = true;
+#else
+	document["build"]["profiling"] = false;
+#endif
+
+	document["benchmarks"] = nlohmann::json::array();
+	for(auto& result : results) {
+		nlohmann::json entry;
+		entry["group"] = result.group;
+		entry["name"] = result.name;
+
+		if(!result.skipped.empty()) {
+			entry["skipped"] = result.skipped;
+			document["benchmarks"].push_back(entry);
+			continue;
+		}
+
+		const auto stats = summarize(result.nsPerOp);
+		entry["iterations"] = result.iterations;
+		entry["ns_per_op"] = {
+			{"median", stats.median},
+			{"mean", stats.mean},
+			{"min", stats.min},
+			{"max", stats.max},
+			{"stddev", stats.stddev}
+		};
+		entry["samples"] = result.nsPerOp;
+		if(!result.counters.empty())
+			entry["counters"] = result.counters;
+		document["benchmarks"].push_back(entry);
+	}
+
+	std::ofstream file(path, std::ios::trunc);
+	if(!file.good()) {
+		std::cerr << "RPGBench/ Could not open '" << path << "' for writing\n";
+		return false;
+	}
+	file << document.dump(1, '\t') << "\n";
+	file.close();
+	if(!file) {
+		std::cerr << "RPGBench/ Failed writing '" << path << "'\n";
+		return false;
+	}
+
+	std::cout << "RPGBench/ Results written to '" << path << "'\n";
+	return true;
+}
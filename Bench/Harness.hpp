@@ -0,0 +1,55 @@
+#pragma once
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ *      Harness - uruchamianie i pomiar benchmarków
+ *  Każdy benchmark wykonuje podaną liczbę operacji w jednym wywołaniu (przygotowanie danych
+ *  może być wtedy amortyzowane na całą próbkę). Po jednej próbce rozgrzewkowej zbierane jest
+ *  `samples` próbek, a wynik to czas na operację (mediana, średnia, min, max, odchylenie).
+ *  Benchmark może dopisać własne liczniki (np. liczba wygranych walk) - trafiają do JSON obok czasów.
+ */
+class Harness {
+public:
+	typedef std::map<std::string, double> Counters;
+
+	struct Run {
+		unsigned iterations;
+		Counters& counters;
+	};
+	typedef std::function<void(Run&)> Function;
+
+	struct Result {
+		std::string group;
+		std::string name;
+		unsigned iterations {0};
+		std::vector<double> nsPerOp;
+		Counters counters;
+		std::string skipped;
+	};
+private:
+	struct Benchmark {
+		std::string group;
+		std::string name;
+		unsigned iterations;
+		Function function;
+	};
+
+	std::vector<Benchmark> benchmarks;
+	std::vector<Result> results;
+	unsigned samples;
+	std::string filter;
+public:
+	Harness(unsigned sampleCount, const std::string& nameFilter)
+	: samples(sampleCount), filter(nameFilter) { }
+
+	void add(const std::string& group, const std::string& name, unsigned iterations, Function function);
+	//  Benchmark, którego nie da się uruchomić (brak mapy, przedmiotów) - odnotowany w wynikach z powodem
+	void skip(const std::string& group, const std::string& name, const std::string& reason);
+
+	void run();
+	void printSummary() const;
+	bool writeJson(const std::string& path, const std::map<std::string, std::string>& config) const;
+};
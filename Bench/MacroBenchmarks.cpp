@@ -0,0 +1,88 @@
+#include <random>
+#include "BenchFixture.hpp"
+
+static const unsigned s_world_ticks = 10000;
+static const unsigned s_walk_segment = 16;		//  co ile ticków gracz zmienia kierunek
+static const unsigned s_battle_count = 1000;
+static const unsigned s_max_battle_turns = 1000;
+
+/*
+ *  Obieg pętli gry bez okna - gracz chodzi losowo (stałe ziarno) tak, jakby trzymał klawisz
+ *  kierunku, a świat, NPC i ich skrypty aktualizują się co tick. Wynik to czas jednego ticku.
+ */
+static void registerWorldRun(Harness& harness, BenchFixture& fixture) {
+	if(!fixture.hasMap()) {
+		harness.skip("macro", "world_10k_ticks", "map '" + fixture.getConfig().map + "' not found");
+		return;
+	}
+
+	harness.add("macro", "world_10k_ticks", s_world_ticks, [&fixture](Harness::Run& run) {
+		auto& world = fixture.getWorld();
+		fixture.resetPlayer();
+
+		std::mt19937 random(fixture.getConfig().seed);
+		std::uniform_int_distribution<unsigned> direction(0, 3);
+		Direction walking = Direction::Down;
+		unsigned moves = 0;
+		for(unsigned tick = 0; tick < run.iterations; ++tick) {
+			if(tick % s_walk_segment == 0)
+				walking = (Direction)direction(random);
+			moves += world.movePlayer(walking);
+			world.updateWorld();
+		}
+		run.counters["player_moves"] = moves;
+	});
+}
+
+/*
+ *  Walki od początku do końca - gracz zawsze wybiera szybki atak. Wynik to czas jednej walki.
+ *  Rejestrowane po przebiegu świata: koniec walki ustawia flagi autozapisu/wczytania gry,
+ *  które obsłużyłby dopiero kolejny WorldManager::updateWorld().
+ */
+static void registerBattleSimulation(Harness& harness, BenchFixture& fixture) {
+	if(!fixture.hasCharacter() || !fixture.hasScript()) {
+		harness.skip("macro", "battle_1k_simulation", "no character spritesheet or enemy script");
+		return;
+	}
+
+	auto enemy = std::make_shared<NPC>(fixture.getConfig().character, Vec2u(0, 0), fixture.getConfig().enemyScript);
+	harness.add("macro", "battle_1k_simulation", s_battle_count, [enemy, &fixture](Harness::Run& run) {
+		auto& battle = fixture.getBattle();
+		battle.Seed(fixture.getConfig().seed);
+
+		unsigned victories = 0, defeats = 0, unfinished = 0, turns = 0;
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			fixture.resetPlayer();
+			BenchFixture::resetEnemy(*enemy);
+			battle.InitBattle(enemy.get(), nullptr);
+
+			auto state = BattleState::InProgress;
+			for(unsigned turn = 0; turn < s_max_battle_turns && state == BattleState::InProgress; ++turn) {
+				battle.Call();
+				state = battle.updateBattle();
+				++turns;
+			}
+
+			switch(state) {
+				case BattleState::Victory: ++victories; break;
+				case BattleState::Defeat:  ++defeats; break;
+				case BattleState::InProgress:
+					++unfinished;
+					battle.EndBattle();
+					break;
+				default: break;
+			}
+		}
+		fixture.resetPlayer();
+
+		run.counters["victories"] = victories;
+		run.counters["defeats"] = defeats;
+		run.counters["unfinished"] = unfinished;
+		run.counters["turns_per_battle"] = (double)turns / run.iterations;
+	});
+}
+
+void registerMacroBenchmarks(Harness& harness, BenchFixture& fixture) {
+	registerWorldRun(harness, fixture);
+	registerBattleSimulation(harness, fixture);
+}
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <SFML/Graphics.hpp>
+#include "BenchFixture.hpp"
+#include "Harness.hpp"
+
+static void printUsage() {
+	std::cout << "Usage: RPGBench [options]\n"
+	          << "  --out <path>         results file (default RPGBench.json)\n"
+	          << "  --filter <text>      run only benchmarks whose name contains text\n"
+	          << "  --samples <n>        measured samples per benchmark (default 10)\n"
+	          << "  --map <name>         map used by map and world benchmarks (default 'default')\n"
+	          << "  --character <name>   NPC spritesheet (default: first available)\n"
+	          << "  --script <name>      script for hook dispatch (default 'testscript')\n"
+	          << "  --seed <n>           random seed (default 1234)\n";
+}
+
+int main(int argc, char** argv) {
+	BenchFixture::Config config;
+	std::string out = "RPGBench.json";
+	std::string filter;
+	unsigned samples = 10;
+
+	for(int i = 1; i < argc; ++i) {
+		const bool hasValue = i + 1 < argc;
+		if(!std::strcmp(argv[i], "--help")) {
+			printUsage();
+			return 0;
+		} else if(!std::strcmp(argv[i], "--out") && hasValue) {
+			out = argv[++i];
+		} else if(!std::strcmp(argv[i], "--filter") && hasValue) {
+			filter = argv[++i];
+		} else if(!std::strcmp(argv[i], "--samples") && hasValue) {
+			samples = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+		} else if(!std::strcmp(argv[i], "--map") && hasValue) {
+			config.map = argv[++i];
+		} else if(!std::strcmp(argv[i], "--character") && hasValue) {
+			config.character = argv[++i];
+		} else if(!std::strcmp(argv[i], "--script") && hasValue) {
+			config.script = argv[++i];
+		} else if(!std::strcmp(argv[i], "--seed") && hasValue) {
+			config.seed = std::strtoul(argv[++i], nullptr, 10);
+		} else {
+			std::cerr << "RPGBench/ Unknown option '" << argv[i] << "'\n";
+			printUsage();
+			return 1;
+		}
+	}
+
+	//  Bez okna - tekstury i bufory wierzchołków potrzebują jedynie kontekstu OpenGL
+	sf::Context context;
+
+	try {
+		BenchFixture fixture(config);
+		Harness harness(samples, filter);
+		registerMicroBenchmarks(harness, fixture);
+		registerMacroBenchmarks(harness, fixture);
+		harness.run();
+		harness.printSummary();
+
+		const auto& used = fixture.getConfig();
+		const std::map<std::string, std::string> configuration {
+			{"map", used.map},
+			{"character", used.character},
+			{"script", used.script},
+			{"enemyScript", used.enemyScript},
+			{"seed", std::to_string(used.seed)},
+			{"filter", filter}
+		};
+		if(!harness.writeJson(out, configuration))
+			return 1;
+	} catch (std::exception& ex) {
+		std::cerr << "RPGBench has encountered an error\n";
+		std::cerr << "Details: " << ex.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
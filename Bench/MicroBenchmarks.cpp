@@ -0,0 +1,222 @@
+#include <random>
+#include "BenchFixture.hpp"
+#include "World/Item.hpp"
+#include "Entity/Script.hpp"
+#include "SaveFormat.hpp"
+
+static const unsigned s_crowd_size = 256;
+static const unsigned s_move_samples = 4096;
+
+/*
+ *  Przykładowy dokument zapisu - te same klucze co w grze, pełny plecak i kilkadziesiąt flag skryptów
+ */
+static nlohmann::json makeSaveDocument(const std::vector<std::string>& designators, std::mt19937& random) {
+	nlohmann::json document;
+	document["playerName"] = "Andrzej";
+	document["playerCurrentMap"] = "default";
+	document["playerCurrentPos"] = {12, 7};
+	document["playerStats"] = {{"HP", 85}, {"MaxHP", 100}, {"MP", 12}, {"MaxMP", 35}, {"Attack", 3}, {"Armor", 1}};
+	document["playerInfo"] = {{"lvl", 4}, {"current", 17}, {"next", 60}, {"gold", 320}};
+
+	std::vector<std::pair<std::string, unsigned>> backpack;
+	std::uniform_int_distribution<unsigned> count(1, 20);
+	for(unsigned i = 0; i < PlayerInventory::defaultSize; ++i) {
+		if(designators.empty() || i % 3 == 2) backpack.push_back({"", 0});
+		else backpack.push_back({designators[i % designators.size()], count(random)});
+	}
+	document["playerBackpack"] = backpack;
+	document["playerEquipment"] = std::vector<std::string>((unsigned)EquipmentSlot::_DummyEnd, "");
+
+	for(unsigned i = 0; i < 64; ++i)
+		document["scriptFlags"]["quest_flag_" + std::to_string(i)] = (int)(random() % 4);
+	return document;
+}
+
+static void registerMapBenchmarks(Harness& harness, BenchFixture& fixture) {
+	if(!fixture.hasMap()) {
+		const std::string reason = "map '" + fixture.getConfig().map + "' not found";
+		for(auto name : {"map_from_file", "map_initialize_vertex_arrays", "map_check_collision", "map_move_actor"})
+			harness.skip("micro", name, reason);
+		return;
+	}
+
+	harness.add("micro", "map_from_file", 10, [&fixture](Harness::Run& run) {
+		for(unsigned i = 0; i < run.iterations; ++i)
+			fixture.loadMap();
+	});
+
+	auto map = fixture.loadMap();
+	harness.add("micro", "map_initialize_vertex_arrays", 20, [map](Harness::Run& run) {
+		for(unsigned i = 0; i < run.iterations; ++i)
+			map->initializeVertexArrays();
+		run.counters["vertex_bytes"] = map->gpuMemory();
+	});
+
+	harness.add("micro", "map_check_collision", 100000, [map, &fixture](Harness::Run& run) {
+		auto& player = fixture.getPlayer();
+		const unsigned tiles = map->getWidth() * map->getHeight();
+		unsigned collisions = 0;
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			const unsigned tile = (i / 4) % tiles;
+			const Vec2u pos(tile % map->getWidth(), tile / map->getWidth());
+			collisions += map->checkCollision(pos, (Direction)(i % 4), player);
+		}
+		run.counters["collisions"] = collisions;
+	});
+
+	//  Stałe pary (pozycja, kierunek) - każdy ruch startuje z zatrzymanego gracza
+	std::mt19937 random(fixture.getConfig().seed);
+	std::vector<std::pair<Vec2u, Direction>> moves;
+	std::uniform_int_distribution<unsigned> x(0, map->getWidth() - 1), y(0, map->getHeight() - 1), dir(0, 3);
+	for(unsigned i = 0; i < s_move_samples; ++i)
+		moves.push_back({Vec2u(x(random), y(random)), (Direction)dir(random)});
+
+	harness.add("micro", "map_move_actor", 100000, [map, moves, &fixture](Harness::Run& run) {
+		auto& player = fixture.getPlayer();
+		unsigned moved = 0;
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			const auto& [pos, dir] = moves[i % moves.size()];
+			player.setPosition(pos);
+			moved += map->moveActor(player, dir);
+		}
+		fixture.resetPlayer();
+		run.counters["moved"] = moved;
+	});
+}
+
+static void registerEntityBenchmarks(Harness& harness, BenchFixture& fixture) {
+	if(!fixture.hasCharacter() || !fixture.hasScript()) {
+		harness.skip("micro", "map_draw_entities", "no character spritesheet or enemy script");
+		return;
+	}
+
+	std::shared_ptr<Map> crowd;
+	try {
+		std::mt19937 random(fixture.getConfig().seed);
+		crowd = fixture.makeCrowdedMap(s_crowd_size, random);
+	} catch (std::exception& ex) {
+		harness.skip("micro", "map_draw_entities", ex.what());
+		return;
+	}
+
+	auto target = std::make_shared<sf::RenderTexture>();
+	if(!target->create(800, 600)) {
+		harness.skip("micro", "map_draw_entities", "could not create render texture");
+		return;
+	}
+
+	//  Mapa nie ma kafelków, więc Map::draw to praktycznie samo sortowanie i rysowanie postaci.
+	//  Pierwsza klatka sortuje losową kolejność, kolejne - jak w grze - prawie posortowaną.
+	harness.add("micro", "map_draw_entities", 200, [crowd, target](Harness::Run& run) {
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			target->clear();
+			crowd->draw(*target);
+		}
+		target->display();
+		run.counters["entities"] = s_crowd_size + 1;
+	});
+}
+
+static void registerScriptBenchmarks(Harness& harness, BenchFixture& fixture) {
+	if(!fixture.hasScript()) {
+		harness.skip("micro", "script_hook_dispatch", "script '" + fixture.getConfig().script + "' not found");
+		return;
+	}
+
+	auto script = std::make_shared<Script>(fixture.getConfig().script);
+	harness.add("micro", "script_hook_dispatch", 10000, [script](Harness::Run& run) {
+		for(unsigned i = 0; i < run.iterations; ++i)
+			script->executeFunction("onUpdate");
+	});
+}
+
+static void registerBattleBenchmarks(Harness& harness, BenchFixture& fixture) {
+	if(!fixture.hasCharacter() || !fixture.hasScript()) {
+		harness.skip("micro", "battle_quick_attack", "no character spritesheet or enemy script");
+		return;
+	}
+
+	auto enemy = std::make_shared<NPC>(fixture.getConfig().character, Vec2u(0, 0), fixture.getConfig().enemyScript);
+	harness.add("micro", "battle_quick_attack", 100000, [enemy, &fixture](Harness::Run& run) {
+		auto& battle = fixture.getBattle();
+		auto& player = fixture.getPlayer();
+		battle.Seed(fixture.getConfig().seed);
+		fixture.resetPlayer();
+
+		double damage = 0.0;
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			BenchFixture::resetEnemy(*enemy);
+			battle.QuickAtack(player, *enemy, true);
+			damage += enemy->getStat("MaxHP") - enemy->getStat("HP");
+		}
+		run.counters["average_damage"] = damage / run.iterations;
+	});
+}
+
+static void registerItemBenchmarks(Harness& harness, BenchFixture& fixture) {
+	const auto& designators = fixture.getItemDesignators();
+	if(designators.empty()) {
+		harness.skip("micro", "inventory_add_item", "ItemList is empty");
+		harness.skip("micro", "item_construct", "ItemList is empty");
+		return;
+	}
+
+	harness.add("micro", "inventory_add_item", 10000, [&fixture, &designators](Harness::Run& run) {
+		fixture.resetPlayer();
+		auto& inventory = fixture.getPlayer().getInventory();
+		//  Kilka różnych przedmiotów - część trafia do istniejących stacków, część do nowych slotów
+		const unsigned kinds = std::min<std::size_t>(designators.size(), 16);
+		unsigned clears = 0;
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			const auto id = (ItemID)(i % kinds);
+			if(!inventory.canFit(id, 1)) {
+				fixture.resetPlayer();
+				++clears;
+			}
+			inventory.addItem(Item{id, 1});
+		}
+		fixture.resetPlayer();
+		run.counters["backpack_clears"] = clears;
+	});
+
+	harness.add("micro", "item_construct", 100000, [&designators](Harness::Run& run) {
+		unsigned long long stacks = 0;
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			Item item {designators[i % designators.size()]};
+			stacks += item.getStack();
+		}
+		run.counters["stacks"] = (double)stacks / run.iterations;
+	});
+}
+
+static void registerSaveBenchmarks(Harness& harness, BenchFixture& fixture) {
+	std::mt19937 random(fixture.getConfig().seed);
+	auto document = std::make_shared<nlohmann::json>(makeSaveDocument(fixture.getItemDesignators(), random));
+
+	//  Poprawność sprawdzana raz, poza pomiarem
+	nlohmann::json decoded;
+	if(!SaveFormat::decode(SaveFormat::encode(*document), decoded) || decoded != *document) {
+		harness.skip("micro", "savefile_roundtrip", "round-trip does not reproduce the document");
+		return;
+	}
+
+	harness.add("micro", "savefile_roundtrip", 1000, [document](Harness::Run& run) {
+		std::size_t bytes = 0;
+		for(unsigned i = 0; i < run.iterations; ++i) {
+			const auto data = SaveFormat::encode(*document);
+			nlohmann::json decoded;
+			SaveFormat::decode(data, decoded);
+			bytes = data.size();
+		}
+		run.counters["bytes"] = bytes;
+	});
+}
+
+void registerMicroBenchmarks(Harness& harness, BenchFixture& fixture) {
+	registerMapBenchmarks(harness, fixture);
+	registerEntityBenchmarks(harness, fixture);
+	registerScriptBenchmarks(harness, fixture);
+	registerBattleBenchmarks(harness, fixture);
+	registerItemBenchmarks(harness, fixture);
+	registerSaveBenchmarks(harness, fixture);
+}
@@ -1,9 +1,11 @@
 #include <memory>
 #include "Engine.hpp"
 #include "World/Item.hpp"
+#include "Profiler.hpp"
 
 bool Engine::Init() {
 	AssetManager::loadMaps();
+	HotReload::start();
 	window = std::make_shared<sf::RenderWindow>(sf::VideoMode(windowWidth, windowHeight, 32), "Projekt");
 	if (!window) return false;
 	window->setFramerateLimit(60);
@@ -21,6 +23,7 @@ bool Engine::Init() {
 }
 
 void Engine::RenderFrame() {
+	PROFILE_SCOPE("Render");
 	window->clear();
 
 	if (scene == BATTLE) {
@@ -60,10 +63,18 @@ void Engine::RenderFrame() {
 		shopEngine.draw(*window);
 	}
 
-	window->display();
+	window->setView(sf::View(sf::Rect(0.f, 0.f, (float)windowWidth, (float)windowHeight)));
+	memoryOverlay.Draw(*window);
+	profilerOverlay.Draw(*window);
+
+	{
+		PROFILE_SCOPE("Display");
+		window->display();
+	}
 }
 
 void Engine::ProcessInput() {
+	PROFILE_SCOPE("Input");
 	sf::Event event;
 	while (window->pollEvent(event)) {
 		switch(event.type) {
@@ -78,6 +89,19 @@ void Engine::ProcessInput() {
 			}
 
 			case sf::Event::KeyPressed: {
+				if (event.key.code == sf::Keyboard::F3) {
+					memoryOverlay.Toggle();
+					break;
+				}
+				if (event.key.code == sf::Keyboard::F4) {
+					profilerOverlay.Toggle();
+					break;
+				}
+				if (event.key.code == sf::Keyboard::F5) {
+					Profiler::writeChromeTrace("profile.json");
+					break;
+				}
+
 				if (scene == INGAME) {
 					if (event.key.code == sf::Keyboard::Space) {
 						world.playerInteract();
@@ -121,9 +145,15 @@ void Engine::ProcessInput() {
 }
 
 void Engine::Update() {
+	PROFILE_SCOPE("Update");
+	HotReload::poll();
+	//  Limity pamięci sprawdzane raz na sekundę - zwalniane są tylko nieużywane zasoby
+	if (++frameCount % 60 == 0)
+		AssetManager::enforceMemoryBudget();
 	world.updateWorld();
 	soundEngine.update();
 	dialogEngine.update();
+	shopEngine.update();
 
 	if(battleEngine.IsActive()) {
 		scene = BATTLE;
@@ -140,6 +170,8 @@ void Engine::Update() {
 
 void Engine::MainLoop() {
 	while (window->isOpen()) {
+		Profiler::beginFrame();
+		PROFILE_SCOPE("Frame");
 		ProcessInput();
 		Update();
 		RenderFrame();
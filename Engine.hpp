@@ -6,6 +6,8 @@
 #include "AssetManager.hpp"
 #include "Interface/Hud.hpp"
 #include "Interface/GameUI.hpp"
+#include "Interface/MemoryOverlay.hpp"
+#include "Interface/ProfilerOverlay.hpp"
 #include "Sound/SoundEngine.hpp"
 #include "Interface/DialogEngine.hpp"
 #include "BattleSystem/BattleEngine.hpp"
@@ -34,6 +36,9 @@ private:
 	ShopEngine shopEngine;
 	GameUI GUI;
 	BattleEngine battleEngine;
+	MemoryOverlay memoryOverlay;
+	ProfilerOverlay profilerOverlay;
+	unsigned frameCount = 0;
 
 	void RenderWorld(sf::RenderTarget&);
 	void RenderHud(sf::RenderTarget&);
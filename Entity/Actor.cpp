@@ -94,3 +94,13 @@ Direction Actor::flipDirection(Direction dir) {
 	else
 		return Direction::Left;
 }
+
+int Actor::getStat(const std::string& name) const {
+	auto it = statistics.find(name);
+	return it != statistics.end() ? it->second : 0;
+}
+
+void Actor::setStat(const std::string& name, int value) {
+	statistics[name] = value;
+	this->onStatsChanged();
+}
@@ -25,6 +25,9 @@ protected:
 	std::queue<Direction> movementQueue;
 	std::map<std::string, int> statistics;
 	void enqueueMove(Direction dir);
+
+	//  Wywoływana po każdej zmianie statystyk przez setStat/modifyStat
+	virtual void onStatsChanged() { }
 public:
 	Actor(unsigned type, unsigned moveSpeed)
 	: entityType(type), movementSpeed(moveSpeed), facing(Direction::Down), isMoving(false), frameCounter(0) { }
@@ -42,7 +45,15 @@ public:
 	Vec2f getSpritePosition() const { return spritePosition; }
 	Direction getDirection()  const { return facing; }
 	unsigned getMoveSpeed()   const { return movementSpeed; }
-	std::map<std::string, int>& getStatistics() { return statistics; }
+	const std::map<std::string, int>& getStatistics() const { return statistics; }
+
+	/*
+	 *  Odczyt i zmiana pojedynczej statystyki. Brakująca statystyka ma wartość 0.
+	 *  Zmiany przechodzą przez setStat, żeby obserwatorzy (np. HUD gracza) o nich wiedzieli.
+	 */
+	int getStat(const std::string& name) const;
+	void setStat(const std::string& name, int value);
+	void modifyStat(const std::string& name, int delta) { setStat(name, getStat(name) + delta); }
 
 	void setFacing(Direction dir) { facing = dir; }
 
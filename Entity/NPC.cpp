@@ -19,6 +19,10 @@ void NPC::onStep() {
 	actorScript->executeFunction("onStep");
 }
 
+bool NPC::scriptYielding() const {
+	return actorScript && actorScript->isYielding();
+}
+
 void NPC::draw(sf::RenderTarget &target) const {
 	sf::Sprite sprite;
 	switch(facing) {
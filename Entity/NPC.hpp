@@ -28,6 +28,8 @@ public:
 	void onInteract(Direction dir) override;
 	void onStep() override;
 
+	bool scriptYielding() const;
+
 	friend class Script;
 	friend class NPCCreator;
 };
\ No newline at end of file
@@ -5,25 +5,26 @@
 Player* Player::instance {nullptr};
 
 Player::Player()
-: Actor(0, 4) {
+: Actor(0, 4), spritesheet(AssetManager::findCharacter("playersprite")) {
 	instance = this;
 	this->loadFromSavegame();
 }
 
 void Player::draw(sf::RenderTarget &target) const {
 	sf::Sprite sprite;
+	const auto& sheet = AssetManager::getSpritesheet(spritesheet);
 	switch(facing) {
 		case Direction::Up:
-			sprite = AssetManager::getCharacter("playersprite").getSprite(3, isMoving ? (frameCounter / movementSpeed) % 4 : 0 );
+			sprite = sheet.getSprite(3, isMoving ? (frameCounter / movementSpeed) % 4 : 0 );
 			break;
 		case Direction::Down:
-			sprite = AssetManager::getCharacter("playersprite").getSprite(0, isMoving ? (frameCounter / movementSpeed) % 4: 0 );
+			sprite = sheet.getSprite(0, isMoving ? (frameCounter / movementSpeed) % 4: 0 );
 			break;
 		case Direction::Left:
-			sprite = AssetManager::getCharacter("playersprite").getSprite(1, isMoving ? (frameCounter / movementSpeed) %4: 0 );
+			sprite = sheet.getSprite(1, isMoving ? (frameCounter / movementSpeed) %4: 0 );
 			break;
 		case Direction::Right:
-			sprite = AssetManager::getCharacter("playersprite").getSprite(2, isMoving ? (frameCounter / movementSpeed) %4: 0 );
+			sprite = sheet.getSprite(2, isMoving ? (frameCounter / movementSpeed) %4: 0 );
 			break;
 		default: break;
 	}
@@ -64,11 +65,6 @@ void Player::setDefaultStatistics() {
 	player_info["current"] = 0;
 	player_info["next"] = 11;
 	player_info["gold"] = 25;
-
-	auto save = AssetManager::getSavefile();
-	save.set("playerStats", statistics);
-	save.set("playerInfo", player_info);
-	save.saveToFile();
 }
 
 void Player::Lvlup() {
@@ -80,6 +76,7 @@ void Player::Lvlup() {
 		statistics["MaxMP"] += (int)(statistics["MaxMP"] * (2.1 / player_info["lvl"]));
 		statistics["HP"] = statistics["MaxHP"];
 		statistics["MP"] = statistics["MaxMP"];
+		notifyStatsChanged();
 	}
 }
 
@@ -90,11 +87,23 @@ void Player::GainEXP(int amount) {
 		Lvlup();
 		player_info["current"] += overflow;
 	}
+	notifyStatsChanged();
 }
 
 void Player::GainGold(int amount) {
 	player_info["gold"] += amount;
 	if (player_info["gold"] > 9999) player_info["gold"] = 9999;
+	notifyStatsChanged();
+}
+
+int Player::getInfo(const std::string& name) const {
+	auto it = player_info.find(name);
+	return it != player_info.end() ? it->second : 0;
+}
+
+void Player::setInfo(const std::string& name, int value) {
+	player_info[name] = value;
+	notifyStatsChanged();
 }
 
 void Player::setPosition(Vec2u worldPos) {
@@ -124,6 +133,7 @@ void Player::loadFromSavegame() {
 	} else {
 		setDefaultStatistics();
 	}
+	notifyStatsChanged();
 
 	if(save.exists("playerCurrentPos"))
 		setPosition(save.get<Vec2u>("playerCurrentPos"));
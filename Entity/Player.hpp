@@ -3,6 +3,7 @@
 #include "Entity/Actor.hpp"
 #include "Graphics/RenderableObject.hpp"
 #include "Entity/PlayerInventory.hpp"
+#include "AssetHandle.hpp"
 
 class Player final : public Actor, protected RenderableObject {
 	friend class Script;
@@ -12,6 +13,8 @@ class Player final : public Actor, protected RenderableObject {
 	std::map<std::string, int> player_info;
 
 	PlayerInventory inventory;
+	unsigned statsRevision {0};
+	TextureHandle spritesheet;
 
 	void saveToSavegame();
 	void loadFromSavegame();
@@ -20,19 +23,30 @@ public:
 
 	void draw(sf::RenderTarget& target) const override;
 	std::string getName() const { return name; }
-	std::map<std::string, int>& getStatistics() { return statistics; }
-	std::map<std::string, int>& getPlayerInfo() { return player_info; }
+	const std::map<std::string, int>& getPlayerInfo() const { return player_info; }
+	int getInfo(const std::string& name) const;
+	void setInfo(const std::string& name, int value);
+	void modifyInfo(const std::string& name, int delta) { setInfo(name, getInfo(name) + delta); }
 	Vec2u getDimensions() const override;
 	void GainEXP(int);
 	void setPosition(Vec2u worldPos);
 	void GainGold(int);
 
+	/*
+	 *  Licznik zmian statystyk i player_info. setStat/setInfo (i ich modify*) podbijają go same;
+	 *  notifyStatsChanged() służy zmianom pośrednim, np. statystykom przedmiotów po przeładowaniu.
+	 *  HUD przerysowuje się tylko gdy licznik się zmieni.
+	 */
+	void notifyStatsChanged() { ++statsRevision; }
+	unsigned getStatsRevision() const { return statsRevision; }
+
 	PlayerInventory& getInventory() { return inventory; }
 protected:
 	void onInteract(Direction dir) override {};
 	void onStep() override {};
 	void onMove(Direction) override {}
 	void onUpdate() override {}
+	void onStatsChanged() override { notifyStatsChanged(); }
 	void Lvlup();
 	void setDefaultStatistics();
 
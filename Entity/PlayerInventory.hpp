@@ -1,4 +1,8 @@
 #pragma once
+#include <map>
+#include <array>
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <cassert>
@@ -6,21 +10,128 @@
 #include "World/Item.hpp"
 #include "Entity/PlayerEquipment.hpp"
 
+class PlayerInventory;
+
+enum class InventorySection {
+	Backpack,
+	Equipment
+};
+
+/*
+ *      SlotHandle - uchwyt na konkretny slot plecaka lub ekwipunku
+ *  Przekazywany do UI i skryptów zamiast kopii przedmiotu, dzięki czemu zawsze wskazuje
+ *  na aktualną zawartość slotu.
+ */
+struct SlotHandle {
+	PlayerInventory* inventory {nullptr};
+	InventorySection section {InventorySection::Backpack};
+	unsigned index {0};
+
+	bool valid() const { return inventory != nullptr; }
+	const ItemSlot& get() const;
+};
+
+/*
+ *  Lista (przedmiot, ilość) - łup z walki, zakup w sklepie, wymagania questa
+ */
+typedef std::vector<std::pair<ItemID, unsigned>> ItemBundle;
+
 class PlayerInventory {
 	friend class WorldManager;
 	friend class Player;
 
+public:
 	static const unsigned defaultSize = 64;
-	std::vector<std::shared_ptr<Item>> backpack;
+	typedef std::array<ItemSlot, defaultSize> Backpack;
+private:
+	/*
+	 *  Indeks slotów plecaka zajętych przez dany przedmiot oraz ich łączna ilość.
+	 *  Aktualizowany przy każdej zmianie slotu (setSlot), więc stackowanie i zapytania
+	 *  "czy gracz ma N sztuk X" nie muszą przeszukiwać całego plecaka.
+	 */
+	struct SlotIndex {
+		std::vector<unsigned> slots;
+		unsigned total {0};
+	};
+
+	Backpack backpack;
 	PlayerEquipment equipment;
+	std::unordered_map<ItemID, SlotIndex> index;
+	unsigned freeSlots {defaultSize};
+	unsigned revision {0};
 
 	unsigned findFirstFree() const {
+		if(freeSlots == 0) return backpack.size();
 		for(unsigned i = 0; i < backpack.size(); i++) {
-			if(!backpack[i]) return i;
+			if(backpack[i].empty()) return i;
 		}
 		return backpack.size();
 	}
 
+	void unindexSlot(unsigned slot) {
+		const auto& item = backpack[slot];
+		if(item.empty()) return;
+
+		auto it = index.find(item.id);
+		assert(it != index.end());
+		auto& entry = it->second;
+		entry.slots.erase(std::find(entry.slots.begin(), entry.slots.end(), slot));
+		entry.total -= item.count;
+		if(entry.slots.empty()) index.erase(it);
+		++freeSlots;
+	}
+
+	void indexSlot(unsigned slot) {
+		const auto& item = backpack[slot];
+		if(item.empty()) return;
+
+		auto& entry = index[item.id];
+		entry.slots.push_back(slot);
+		entry.total += item.count;
+		--freeSlots;
+	}
+
+	void setSlot(unsigned slot, const ItemSlot& item) {
+		++revision;
+		unindexSlot(slot);
+		backpack[slot] = item;
+		if(backpack[slot].count == 0) backpack[slot].clear();
+		indexSlot(slot);
+	}
+
+	void rebuildIndex() {
+		++revision;
+		index.clear();
+		freeSlots = backpack.size();
+		for(unsigned i = 0; i < backpack.size(); ++i)
+			indexSlot(i);
+	}
+
+	/*
+	 *  Ile sztuk danego przedmiotu zmieści się jeszcze w istniejących stackach
+	 */
+	unsigned stackRoom(ItemID id) const {
+		auto it = index.find(id);
+		if(it == index.end()) return 0;
+		const unsigned maxStack = ItemRegistry::getDefinition(id).maxStack;
+		const unsigned capacity = it->second.slots.size() * maxStack;
+		return it->second.total < capacity ? capacity - it->second.total : 0;
+	}
+
+	/*
+	 *  Sumuje powtarzające się pozycje, żeby sprawdzanie i wstawianie operowało na całkowitych ilościach
+	 */
+	static ItemBundle mergeBundle(const ItemBundle& items) {
+		ItemBundle merged;
+		for(const auto& [id, count] : items) {
+			if(id == ItemRegistry::invalidID || count == 0) continue;
+			auto it = std::find_if(merged.begin(), merged.end(), [id = id](const auto& a) { return a.first == id; });
+			if(it == merged.end()) merged.push_back({id, count});
+			else it->second += count;
+		}
+		return merged;
+	}
+
 	void loadFromSavegame() {
 		auto save = AssetManager::getSavefile();
 		if(save.exists("playerBackpack")) {
@@ -29,14 +140,22 @@ class PlayerInventory {
 				std::cerr << "Savegame invalid! Mismatched backpack size\n";
 			}
 
-			backpack.clear();
-			backpack.resize(defaultSize);
+			for(auto& slot : backpack)
+				slot.clear();
 
 			for(unsigned i = 0; i < defaultSize && i < saved_backpack.size(); ++i) {
-				auto pair = saved_backpack[i];
-				if(!pair.first.empty() && pair.second != 0)
-					backpack[i] = std::make_shared<Item>(pair.first, pair.second);
+				const auto& pair = saved_backpack[i];
+				if(pair.first.empty() || pair.second == 0) continue;
+
+				auto id = ItemRegistry::findID(pair.first);
+				if(id == ItemRegistry::invalidID) {
+					std::cerr << "Savegame contains unknown item '" << pair.first << "', skipping\n";
+					continue;
+				}
+				backpack[i] = Item{id, pair.second};
 			}
+			rebuildIndex();
+			clampStacks();
 		}
 
 		if(save.exists("playerEquipment")) {
@@ -48,10 +167,14 @@ class PlayerInventory {
 			equipment.clear();
 
 			for(unsigned i = 0; i < (unsigned)EquipmentSlot::_DummyEnd && i < saved_equipment.size(); ++i) {
-				if(!saved_equipment[i].empty())
-					equipment.setEquipment((EquipmentSlot)i,
-				                           std::make_shared<Item>(saved_equipment[i]));
+				if(saved_equipment[i].empty()) continue;
 
+				auto id = ItemRegistry::findID(saved_equipment[i]);
+				if(id == ItemRegistry::invalidID) {
+					std::cerr << "Savegame contains unknown item '" << saved_equipment[i] << "', skipping\n";
+					continue;
+				}
+				equipment.setEquipment((EquipmentSlot)i, Item{id});
 			}
 		}
 
@@ -60,33 +183,31 @@ class PlayerInventory {
 	void saveToSavegame() {
 		auto save = AssetManager::getSavefile();
 		std::vector<std::pair<std::string, unsigned>> backpackVec;
-		for(auto& item : backpack) {
-			if(!item)
+		backpackVec.reserve(backpack.size());
+		for(auto& slot : backpack) {
+			if(slot.empty())
 				backpackVec.push_back({"", 0});
 			else
-				backpackVec.push_back({item->getDesignator(), item->getStack()});
+				backpackVec.push_back({slot.getDefinition().designator, slot.count});
 		}
 		save.set("playerBackpack", backpackVec);
 
 		std::vector<std::string> eqVec;
+		eqVec.reserve((unsigned)EquipmentSlot::_DummyEnd);
 		for(unsigned i = 0; i < (unsigned)EquipmentSlot::_DummyEnd; ++i) {
-			auto item = equipment.getEquipmentBySlot((EquipmentSlot)i);
-			eqVec.push_back(item ? item->getDesignator()
-								 : "");
+			const auto& slot = equipment.getEquipmentBySlot((EquipmentSlot)i);
+			eqVec.push_back(!slot.empty() ? slot.getDefinition().designator
+			                              : "");
 		}
 		save.set("playerEquipment", eqVec);
 	}
 public:
 	PlayerInventory() {
-		backpack.resize(defaultSize);
+		rebuildIndex();
 		loadFromSavegame();
 	}
 
-	const std::vector<std::shared_ptr<Item>>& getBackpack() const {
-		return backpack;
-	}
-
-	std::vector<std::shared_ptr<Item>>& getBackpack() {
+	const Backpack& getBackpack() const {
 		return backpack;
 	}
 
@@ -98,67 +219,209 @@ public:
 		return equipment;
 	}
 
-	std::shared_ptr<Item> getItem(unsigned index) {
+	const ItemSlot& getItem(unsigned index) const {
 		assert(index < backpack.size());
 		return backpack[index];
 	}
 
-	unsigned addItem(const Item& item) {
-		for(auto& backItem : backpack) {
-			if(!backItem) continue;
-			if(*backItem == item) {
-				if(backItem->getStack() == backItem->getMaxStack()) continue;
-				unsigned overflow = backItem->addStack(item.getStack());
-				if(overflow == 0) return 0;
-				if(overflow > 0) return addItem(item);
-			}
+	void setItem(unsigned index, const ItemSlot& item) {
+		assert(index < backpack.size());
+		setSlot(index, item);
+	}
+
+	/*
+	 *  Licznik zmian plecaka i ekwipunku. UI porównuje go z zapamiętaną wartością,
+	 *  żeby przebudować swoją geometrię tylko wtedy, gdy zawartość faktycznie się zmieniła.
+	 */
+	unsigned getRevision() const {
+		return revision + equipment.getRevision();
+	}
+
+	SlotHandle getHandle(InventorySection section, unsigned index) {
+		return SlotHandle{this, section, index};
+	}
+
+	unsigned countItem(ItemID id) const {
+		auto it = index.find(id);
+		return it == index.end() ? 0 : it->second.total;
+	}
+
+	bool hasItem(ItemID id, unsigned count = 1) const {
+		return countItem(id) >= count;
+	}
+
+	bool hasItems(const ItemBundle& items) const {
+		for(const auto& [id, count] : mergeBundle(items)) {
+			if(!hasItem(id, count)) return false;
 		}
+		return true;
+	}
+
+	/*
+	 *  Sprawdza czy cała lista zmieści się w plecaku - najpierw w istniejących stackach,
+	 *  reszta w wolnych slotach
+	 */
+	bool canFit(const ItemBundle& items) const {
+		unsigned slotsNeeded = 0;
+		for(const auto& [id, count] : mergeBundle(items)) {
+			const unsigned room = stackRoom(id);
+			if(count <= room) continue;
+
+			const unsigned maxStack = ItemRegistry::getDefinition(id).maxStack;
+			slotsNeeded += (count - room + maxStack - 1) / maxStack;
+			if(slotsNeeded > freeSlots) return false;
+		}
+		return true;
+	}
 
-		for(auto& backItem : backpack) {
-			if(!backItem) {
-				backItem = std::make_shared<Item>(item);
-				return 0;
+	bool canFit(ItemID id, unsigned count) const {
+		return canFit(ItemBundle{{id, count}});
+	}
+
+	/*
+	 *  Ile sztuk przedmiotu zmieści się jeszcze w plecaku - istniejące stacki i wolne sloty
+	 */
+	unsigned roomFor(ItemID id) const {
+		if(id == ItemRegistry::invalidID) return 0;
+		return stackRoom(id) + freeSlots * ItemRegistry::getDefinition(id).maxStack;
+	}
+
+	/*
+	 *  Stacki większe niż pozwala definicja (stary zapis, przeładowana lista przedmiotów) są
+	 *  przycinane do maxStack, a nadmiar trafia do wolnych slotów plecaka
+	 */
+	void clampStacks() {
+		ItemBundle excess;
+		for(auto& item : backpack) {
+			if(item.empty()) continue;
+			const unsigned maxStack = item.getDefinition().maxStack;
+			if(item.count <= maxStack) continue;
+			excess.push_back({item.id, item.count - maxStack});
+			item.count = maxStack;
+		}
+		if(excess.empty()) return;
+
+		rebuildIndex();
+		for(const auto& [id, count] : excess) {
+			if(auto lost = addItems(id, count))
+				std::cerr << "PlayerInventory/ No room for " << lost << " x '" << ItemRegistry::getDefinition(id).designator << "' over the stack limit, dropping them\n";
+		}
+	}
+
+	/*
+	 *  Dodaje przedmioty, uzupełniając najpierw istniejące stacki.
+	 *  Zwraca ilość która nie zmieściła się w plecaku.
+	 */
+	unsigned addItems(ItemID id, unsigned count) {
+		if(id == ItemRegistry::invalidID) return count;
+		const unsigned maxStack = ItemRegistry::getDefinition(id).maxStack;
+
+		auto it = index.find(id);
+		if(it != index.end()) {
+			auto& entry = it->second;
+			for(auto slot : entry.slots) {
+				if(count == 0) break;
+				auto& item = backpack[slot];
+				unsigned moved = std::min(count, item.count < maxStack ? maxStack - item.count : 0u);
+				item.count += moved;
+				entry.total += moved;
+				count -= moved;
+				if(moved) ++revision;
 			}
 		}
 
-		std::cerr << "Failed to insert into inventory, inventory full\n";
-		return backpack.size();
+		while(count > 0) {
+			unsigned slot = findFirstFree();
+			if(slot == backpack.size()) break;
+
+			unsigned moved = std::min(count, maxStack);
+			setSlot(slot, ItemSlot{Item{id, moved}});
+			count -= moved;
+		}
+		return count;
+	}
+
+	/*
+	 *  Dodaje całą listę albo nic - łup lub zakup nie może przepaść w połowie
+	 */
+	bool addItems(const ItemBundle& items) {
+		if(!canFit(items)) {
+			std::cerr << "Failed to insert into inventory, inventory full\n";
+			return false;
+		}
+		for(const auto& [id, count] : mergeBundle(items))
+			addItems(id, count);
+		return true;
+	}
+
+	unsigned addItem(const Item& item) {
+		if(!addItems(ItemBundle{{item.getID(), item.getStack()}}))
+			return backpack.size();
+		return 0;
+	}
+
+	/*
+	 *  Zabiera przedmioty, zaczynając od ostatnio zajętych slotów.
+	 *  Zwraca ilość której nie udało się zabrać.
+	 */
+	unsigned removeItems(ItemID id, unsigned count) {
+		auto it = index.find(id);
+		while(count > 0 && it != index.end()) {
+			const unsigned slot = it->second.slots.back();
+			auto item = backpack[slot];
+			unsigned taken = std::min(count, (unsigned)item.count);
+			item.count -= taken;
+			count -= taken;
+
+			setSlot(slot, item);
+			it = index.find(id);
+		}
+		return count;
+	}
+
+	bool removeItems(const ItemBundle& items) {
+		if(!hasItems(items)) return false;
+		for(const auto& [id, count] : mergeBundle(items))
+			removeItems(id, count);
+		return true;
 	}
 
 	void swapItems(unsigned index1, unsigned index2) {
 		assert(index1 < backpack.size() && index2 < backpack.size());
-		std::swap(backpack[index1], backpack[index2]);
+		if(index1 == index2) return;
+		ItemSlot first = backpack[index1];
+		setSlot(index1, backpack[index2]);
+		setSlot(index2, first);
 	}
 
-	bool findItem(const Item& item) {
-		return std::find_if(backpack.begin(),backpack.end(),[&](std::shared_ptr<Item>& a){
-			return *a == item;
-		}) != backpack.end();
+	bool findItem(const Item& item) const {
+		return hasItem(item.getID());
 	}
 
 	bool deleteItem(unsigned toDelete) {
-		if (!backpack[toDelete]) return false;
+		if (backpack[toDelete].empty()) return false;
 		else {
-			backpack[toDelete] = nullptr;
+			setSlot(toDelete, ItemSlot{});
 			return true;
 		}
 	}
 
 	bool useItem(unsigned toUse) {
-		if (!backpack[toUse]) return false;
+		if (backpack[toUse].empty()) return false;
 		else {
-			std::cout << "Uzyto przedmiotu: " << backpack[toUse]->getName() << "." << std::endl;
+			std::cout << "Uzyto przedmiotu: " << backpack[toUse].getDefinition().name << "." << std::endl;
+			backpack[toUse].toItem().onUse();
 			this->tryEquipFromBackpack(toUse);
 			return true;
 		}
 	}
 
 	bool tryEquipFromBackpack(unsigned slot) {
-        if(slot > backpack.size()) return false;
-        auto& item = backpack[slot];
-        if(!item) return false;
+        if(slot >= backpack.size()) return false;
+        const auto& item = backpack[slot];
+        if(item.empty()) return false;
 
-        auto type = item->getType();
+        auto type = item.getDefinition().type;
         EquipmentSlot eqSlot;
         switch(type) {
         	case ItemType::WeaponSword: eqSlot = EquipmentSlot::Weapon; break;
@@ -176,19 +439,48 @@ public:
 	        default: return false;
         }
 
-		auto eqItem = equipment.getEquipmentBySlot(eqSlot);
-		if(!eqItem) {
-			assert(equipment.setEquipment(eqSlot, item));
-			item = nullptr;
-			return true;
-		} else {
-			assert(equipment.setEquipment(eqSlot, item));
-			item = eqItem;
-			return true;
-		}
+		return swapWithEquipment(slot, eqSlot);
+	}
+
+	/*
+	 *  Zamienia zawartość slotu plecaka i slotu ekwipunku - pusty slot plecaka zdejmuje przedmiot.
+	 *  Każda zmiana ekwipunku przechodzi tędy (lub przez removeEquipment), żeby skrypty onEquip
+	 *  zdejmowanego i zakładanego przedmiotu zawsze zostały wywołane.
+	 */
+	bool swapWithEquipment(unsigned slot, EquipmentSlot eqSlot) {
+		if(slot >= backpack.size()) return false;
+
+		const ItemSlot removed = equipment.getEquipmentBySlot(eqSlot);
+		const ItemSlot added = backpack[slot];
+		if(!equipment.setEquipment(eqSlot, added))
+			return false;
+		setSlot(slot, removed);
+
+		if(!removed.empty()) removed.toItem().onEquip(true);
+		if(!added.empty()) added.toItem().onEquip();
+		return true;
+	}
+
+	/*
+	 *  Zdejmuje i usuwa założony przedmiot
+	 */
+	bool removeEquipment(EquipmentSlot eqSlot) {
+		const ItemSlot removed = equipment.getEquipmentBySlot(eqSlot);
+		if(removed.empty() || !equipment.setEquipment(eqSlot, ItemSlot{}))
+			return false;
+
+		removed.toItem().onEquip(true);
+		return true;
 	}
 
 	std::map<std::string, int> SummaryBonusStats() {
 		//std::map<std::string, int> result;
 	}
 };
+
+inline const ItemSlot& SlotHandle::get() const {
+	assert(inventory);
+	if(section == InventorySection::Equipment)
+		return inventory->getEquipment().getEquipmentBySlot((EquipmentSlot)index);
+	return inventory->getItem(index);
+}
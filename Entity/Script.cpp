@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <BattleSystem/BattleEngine.hpp>
 #include "Sound/SoundEngine.hpp"
@@ -8,6 +9,22 @@
 #include "Interface/ShopEngine.hpp"
 #include "Player.hpp"
 
+/*
+ *  Tabela {designator = ilość} ze skryptu - odrzucana w całości, jeśli którykolwiek przedmiot
+ *  nie istnieje albo ilość nie jest nieujemną liczbą całkowitą
+ */
+static bool readBundle(const sol::table& items, ItemBundle& bundle) {
+	for(auto& [key, value] : items) {
+		if(!key.is<std::string>() || !value.is<unsigned>() || value.as<double>() < 0.0)
+			return false;
+
+		auto id = ItemRegistry::findID(key.as<std::string>());
+		if(id == ItemRegistry::invalidID) return false;
+		bundle.push_back({id, value.as<unsigned>()});
+	}
+	return true;
+}
+
 void Script::initBindings() {
 	m_lua_state.set_function("log", [this](const std::string& str) {
 		std::cout << m_script_name << "/ " << str << "\n";
@@ -23,21 +40,78 @@ void Script::initBindings() {
 	                                            "moveSpeed", &NPC::movementSpeed,
 	                                            "move", &NPC::enqueueMove,
 	                                            "moving", &NPC::isMoving,
-	                                            "statistics", &NPC::statistics
+	                                            "getStat", [](const NPC& npc, const std::string& name) { return npc.getStat(name); },
+	                                            "setStat", [](NPC& npc, const std::string& name, int value) { npc.setStat(name, value); }
 	                                            );
-	m_lua_state.new_usertype<Player>("Player", "giveItem",
-			[](Player& player, const std::string& item, unsigned count) -> void {
-				if(count == 0 || item.empty()) return;
-				const auto& list = AssetManager::getJSON("ItemList");
-				if(!list.contains(item)) return;
-
-				player.getInventory().addItem(*std::make_shared<Item>(item, count));
-				return;
+	m_lua_state.new_usertype<SlotHandle>("SlotHandle",
+			"empty", [](const SlotHandle& handle) { return handle.get().empty(); },
+			"item", [](const SlotHandle& handle) -> std::string {
+				if(handle.get().empty()) return "";
+				return handle.get().getDefinition().designator;
+			},
+			"count", [](const SlotHandle& handle) -> unsigned { return handle.get().count; });
+
+	m_lua_state.new_usertype<Player>("Player",
+			"getStat", [](const Player& player, const std::string& name) { return player.getStat(name); },
+			"setStat", [](Player& player, const std::string& name, int value) { player.setStat(name, value); },
+			"getInfo", &Player::getInfo,
+			"setInfo", &Player::setInfo,
+			"giveItem",
+			[](Player& player, const std::string& item, unsigned count) -> bool {
+				if(count == 0 || item.empty()) return false;
+				auto id = ItemRegistry::findID(item);
+				if(id == ItemRegistry::invalidID) return false;
+
+				//  Ilość większa niż jeden stack trafia do kilku slotów
+				return player.getInventory().addItems(ItemBundle{{id, count}});
+			},
+			"hasItem", [](Player& player, const std::string& item, sol::optional<unsigned> count) -> bool {
+				auto id = ItemRegistry::findID(item);
+				if(id == ItemRegistry::invalidID) return false;
+				return player.getInventory().hasItem(id, count.value_or(1));
+			},
+			"countItem", [](Player& player, const std::string& item) -> unsigned {
+				auto id = ItemRegistry::findID(item);
+				if(id == ItemRegistry::invalidID) return 0;
+				return player.getInventory().countItem(id);
+			},
+			"takeItem", [](Player& player, const std::string& item, unsigned count) -> bool {
+				auto id = ItemRegistry::findID(item);
+				if(id == ItemRegistry::invalidID) return false;
+				return player.getInventory().removeItems(ItemBundle{{id, count}});
+			},
+			"giveItems", [](Player& player, sol::table items) -> bool {
+				ItemBundle bundle;
+				if(!readBundle(items, bundle)) return false;
+				return player.getInventory().addItems(bundle);
+			},
+			"takeItems", [](Player& player, sol::table items) -> bool {
+				ItemBundle bundle;
+				if(!readBundle(items, bundle)) return false;
+				return player.getInventory().removeItems(bundle);
+			},
+			"backpackSlot", [](Player& player, unsigned index) -> sol::optional<SlotHandle> {
+				if(index >= PlayerInventory::defaultSize) return sol::nullopt;
+				return player.getInventory().getHandle(InventorySection::Backpack, index);
+			},
+			"equipmentSlot", [](Player& player, unsigned index) -> sol::optional<SlotHandle> {
+				if(index >= (unsigned)EquipmentSlot::_DummyEnd) return sol::nullopt;
+				return player.getInventory().getHandle(InventorySection::Equipment, index);
 			});
 
 	m_lua_state.new_usertype<SoundEngine>("SoundEngine",
-			"playSound", &SoundEngine::playSound,
-			"playMusic", &SoundEngine::playMusic);
+			"playSound", [](SoundEngine& engine, const std::string& name, sol::optional<unsigned> priority) {
+				if(priority && *priority > (unsigned)SoundPriority::Critical) priority = (unsigned)SoundPriority::Critical;
+				return engine.playSound(name, (SoundPriority)priority.value_or((unsigned)SoundPriority::Normal));
+			},
+			"preload", [](SoundEngine& engine, sol::table names) {
+				std::vector<std::string> manifest;
+				for(unsigned i = 1; i <= names.size(); ++i)
+					manifest.push_back(names[i].get<std::string>());
+				engine.preload(manifest);
+			},
+			"playMusic", &SoundEngine::playMusic,
+			"setCrossfade", &SoundEngine::setCrossfadeTime);
 
 	m_lua_state.new_usertype<DialogEngine>("DialogEngine",
 			"say", sol::yielding(
@@ -103,6 +177,15 @@ void Script::initBindings() {
 	m_lua_state.set("player", Player::instance);
 	m_lua_state.set("shop", ShopEngine::instance);
 	m_lua_state.set("battle", BattleEngine::instance);
+	m_lua_state.set_function("isSaving", &Savefile::saveInProgress);
+
+	//  Flagi skryptów (postęp zadań, odbyte rozmowy) - zapisywane razem z grą
+	m_lua_state.set_function("setFlag", [](const std::string& name, int value) {
+		AssetManager::getSavefile().setFlag(name, value);
+	});
+	m_lua_state.set_function("getFlag", [](const std::string& name) {
+		return AssetManager::getSavefile().getFlag(name);
+	});
 }
 
 Script::Script(const std::string &scriptName) {
@@ -110,18 +193,78 @@ Script::Script(const std::string &scriptName) {
 	m_is_yielding = false;
 	m_scheduler = CoroutineScheduler::None;
 
-	std::ifstream file("GameContent/Script/" + scriptName + ".lua");
-	if(!file.good()) {
+	std::string script;
+	if(!AssetManager::readContent("GameContent/Script/" + scriptName + ".lua", script)) {
 		std::cerr << "Error loading Lua script from file!\n";
 		std::cerr << "Tried loading from path " << "GameContent/Script/"+scriptName+".lua" << "\n";
-		file.close();
 		throw std::runtime_error("Script load failed");
 	}
-	std::string script((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-	file.close();
 
 	m_lua_state.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::string, sol::lib::io, sol::lib::math);
 
 	this->initBindings();
 	m_lua_state.script(script);
+
+	liveScripts().push_back(this);
+}
+
+Script::~Script() {
+	auto& scripts = liveScripts();
+	scripts.erase(std::remove(scripts.begin(), scripts.end(), this), scripts.end());
+}
+
+/*
+ *  Wszystkie istniejące skrypty - by przeładować każdą instancję zmienionego pliku.
+ *  Lista nie jest nigdy niszczona: skrypty trzymane w statycznych mapach (Item, AssetManager)
+ *  wyrejestrowują się w swoich destruktorach, już po zniszczeniu lokalnych zmiennych statycznych.
+ */
+std::vector<Script*>& Script::liveScripts() {
+	static auto* scripts = new std::vector<Script*>;
+	return *scripts;
+}
+
+/*
+ *  Ponownie wykonuje plik skryptu w istniejącym stanie Lua - funkcje zostają podmienione,
+ *  a zmienne globalne (stan NPC, powiązania z silnikiem) pozostają. Skrypt czekający na dialog
+ *  lub sklep zostanie przeładowany dopiero po wznowieniu i zakończeniu korutyny.
+ */
+bool Script::reload() {
+	if(m_is_yielding) {
+		m_reload_pending = true;
+		return true;
+	}
+	m_reload_pending = false;
+
+	std::string script;
+	if(!AssetManager::readContent("GameContent/Script/" + m_script_name + ".lua", script)) {
+		std::cerr << "Script::reload()/ Failed reading script '" << m_script_name << "'\n";
+		return false;
+	}
+
+	auto result = m_lua_state.safe_script(script, sol::script_pass_on_error);
+	if(!result.valid()) {
+		sol::error err = result;
+		std::cerr << "Script::reload()/ Error reloading script '" << m_script_name << "'\n";
+		std::cerr << "Details: " << err.what() << "\n";
+		return false;
+	}
+	return true;
+}
+
+MemoryUsage Script::memoryUsage() {
+	MemoryUsage usage;
+	for(auto* script : liveScripts()) {
+		usage.cpu += script->m_lua_state.memory_used();
+		++usage.count;
+	}
+	return usage;
+}
+
+bool Script::reloadAll(const std::string &scriptName) {
+	bool ok = true;
+	for(auto* script : liveScripts()) {
+		if(script->m_script_name == scriptName)
+			ok &= script->reload();
+	}
+	return ok;
 }
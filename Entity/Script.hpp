@@ -1,7 +1,10 @@
 #pragma once
 #include <string>
+#include <vector>
 #define SOL_ALL_SAFETIES_ON 1
 #include <sol/sol.hpp>
+#include "MemoryBudget.hpp"
+#include "Profiler.hpp"
 
 enum class CoroutineScheduler {
 	None,
@@ -24,19 +27,41 @@ class Script {
 	std::string m_yielding_coroutine;
 	CoroutineScheduler m_scheduler;
 
+	//  Plik skryptu zmienił się, gdy korutyna czekała - przeładowanie po jej zakończeniu
+	bool m_reload_pending {false};
+
 	void initBindings();
+	static std::vector<Script*>& liveScripts();
 public:
 	Script() { }
 	Script(const std::string&);
+	Script(const Script&) = delete;
+	Script& operator=(const Script&) = delete;
+	~Script();
+
+	const std::string& getName() const { return m_script_name; }
+	bool isYielding() const { return m_is_yielding; }
+
+	bool reload();
+	static bool reloadAll(const std::string& scriptName);
+
+	//  Pamięć zajmowana przez stany Lua wszystkich istniejących skryptów
+	static MemoryUsage memoryUsage();
 
 	template<typename... Args>
 	void set(Args&&... args) {
 		m_lua_state.set(std::forward<Args>(args)...);
 	}
 
+	//  Czy skrypt definiuje funkcję o podanej nazwie - opcjonalne funkcje (np. onEquip przedmiotu)
+	bool hasFunction(const std::string& name) {
+		return m_lua_state[name].get_type() == sol::type::function;
+	}
+
 	template<typename... Args>
 	void executeFunction(const std::string& name, Args&&... args) {
 		if(m_is_yielding) return;
+		PROFILE_SCOPE("Lua script");
 
 		m_scheduler = CoroutineScheduler::None;
 		sol::coroutine func = m_lua_state[name];
@@ -96,6 +121,7 @@ public:
 			std::cout << "The coroutine has finished, my job here is done\n";
 			m_is_yielding = false;
 			m_yielding_coroutine = "";
+			if(m_reload_pending) reload();
 			return CoroutineStatus::Finished;
 		}
 	}
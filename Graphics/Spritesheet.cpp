@@ -1,12 +1,40 @@
 #include <iostream>
+#include <utility>
 #include <SFML/Graphics.hpp>
 #include "Graphics/Spritesheet.hpp"
 
+/*
+ *  sf::Texture nie ma konstruktora przenoszącego, więc tekstura jest zamieniana zamiast kopiowana
+ */
 Spritesheet::Spritesheet(sf::Texture &&texture, Vec2u defaultDimensions) {
-	m_texture = texture;
+	m_texture.swap(texture);
 	m_sprite_size = defaultDimensions;
-	m_animations = texture.getSize().y / defaultDimensions.y;
-	m_frames = texture.getSize().x / defaultDimensions.x;
+	m_animations = m_texture.getSize().y / defaultDimensions.y;
+	m_frames = m_texture.getSize().x / defaultDimensions.x;
+}
+
+Spritesheet::Spritesheet(Spritesheet &&other) noexcept {
+	swap(other);
+}
+
+Spritesheet& Spritesheet::operator=(Spritesheet &&other) noexcept {
+	swap(other);
+	return *this;
+}
+
+void Spritesheet::swap(Spritesheet &other) noexcept {
+	m_texture.swap(other.m_texture);
+	std::swap(m_sprite_size, other.m_sprite_size);
+	std::swap(m_animations, other.m_animations);
+	std::swap(m_frames, other.m_frames);
+}
+
+/*
+ *  Jawna kopia - tworzy nową teksturę na GPU
+ */
+Spritesheet Spritesheet::clone() const {
+	sf::Texture texture(m_texture);
+	return Spritesheet(std::move(texture), m_sprite_size);
 }
 
 /*
@@ -7,18 +7,29 @@
  *  Każdy spritesheet posiada wewnętrznie teksture (całą zawartość jakiegoś pliku graficznego) oraz rozmiar sprite'a
  *  Na podstawie rozmiaru sprite'a tekstura dzielona jest na "animacje" i "ramki". Patrząc graficzne, "animacje"
  *  idą wierszami, a "ramki" kolumnami.
+ *
+ *  Spritesheet nie jest kopiowalny - kopia oznaczałaby duplikat tekstury na GPU. Można go przenieść,
+ *  a jeśli kopia jest naprawdę potrzebna, trzeba o nią poprosić jawnie przez clone().
  */
 
 class Spritesheet {
 	sf::Texture m_texture;
-	Vec2u m_sprite_size;
+	Vec2u m_sprite_size {};
 
-	unsigned m_animations;
-	unsigned m_frames;
+	unsigned m_animations {0};
+	unsigned m_frames {0};
 public:
 	Spritesheet() {}
 	Spritesheet(sf::Texture&& texture, Vec2u defaultDimensions);
 
+	Spritesheet(const Spritesheet&) = delete;
+	Spritesheet& operator=(const Spritesheet&) = delete;
+	Spritesheet(Spritesheet&& other) noexcept;
+	Spritesheet& operator=(Spritesheet&& other) noexcept;
+
+	Spritesheet clone() const;
+	void swap(Spritesheet& other) noexcept;
+
 	sf::Sprite getSprite(unsigned index=0) const;
 	sf::Sprite getSprite(unsigned animation, unsigned frame) const;
 	sf::IntRect getTextureCoordinates(unsigned animation, unsigned frame) const;
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include "HotReload.hpp"
+#include "AssetManager.hpp"
+#include "Profiler.hpp"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+HotReload::~HotReload() {
+	close();
+}
+
+/*
+ *  Zaczyna śledzić katalogi z zasobami, które da się przeładować
+ *  Bez inotify (inne systemy) przeładowywanie jest po prostu niedostępne.
+ */
+bool HotReload::start(const std::string& root) {
+	auto& reload = get();
+	if(reload.inotifyFd >= 0) return true;
+
+	if(AssetManager::usingPack()) {
+		std::cout << "HotReload/ Assets are read from the asset pack, hot reload disabled\n";
+		return false;
+	}
+
+#ifdef __linux__
+	reload.inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(reload.inotifyFd < 0) {
+		std::cerr << "HotReload::start() failed initializing inotify\n";
+		return false;
+	}
+
+	bool ok = reload.watch(root);
+	for(const char* directory : {"/Map", "/Tilesets", "/Script"})
+		ok &= reload.watch(root + directory);
+
+	if(!ok) std::cerr << "HotReload::start() could not watch every content directory, some changes will be missed\n";
+	std::cout << "HotReload/ Watching '" << root << "' for changes\n";
+	return true;
+#else
+	std::cout << "HotReload/ Hot reload is not supported on this platform\n";
+	return false;
+#endif
+}
+
+void HotReload::stop() {
+	get().close();
+}
+
+bool HotReload::watch(const std::string& directory) {
+#ifdef __linux__
+	//  Edytory często zapisują do pliku tymczasowego i podmieniają go - stąd IN_MOVED_TO
+	int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if(wd < 0) {
+		std::cerr << "HotReload::watch() failed watching '" << directory << "'\n";
+		return false;
+	}
+	watches.emplace_back(wd, directory);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void HotReload::close() {
+#ifdef __linux__
+	if(inotifyFd >= 0) ::close(inotifyFd);
+#endif
+	inotifyFd = -1;
+	watches.clear();
+	pending.clear();
+}
+
+/*
+ *  Zamienia zdarzenia inotify na listę zmienionych zasobów
+ *  Kilka zapisów tego samego pliku w jednej klatce daje jedno przeładowanie.
+ */
+void HotReload::readEvents() {
+#ifdef __linux__
+	alignas(inotify_event) char buffer[4096];
+	for(;;) {
+		const auto length = ::read(inotifyFd, buffer, sizeof(buffer));
+		if(length <= 0) break;
+
+		for(const char* ptr = buffer; ptr < buffer + length; ) {
+			const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+			ptr += sizeof(inotify_event) + event->len;
+			if(!event->len) continue;
+
+			auto watch = std::find_if(watches.begin(), watches.end(), [event](const std::pair<int, std::string>& w) {
+				return w.first == event->wd;
+			});
+			if(watch == watches.end()) continue;
+
+			const std::string directory = std::filesystem::path(watch->second).filename().string();
+			const std::filesystem::path file = event->name;
+			const auto extension = file.extension();
+
+			AssetChange change;
+			change.name = file.stem().string();
+			change.path = watch->second + "/" + file.string();
+			if(directory == "Map" && extension == ".json")
+				change.kind = AssetKind::Map;
+			else if(directory == "Tilesets" && (extension == ".json" || extension == ".png"))
+				change.kind = AssetKind::Tileset;
+			else if(directory == "Script" && extension == ".lua")
+				change.kind = AssetKind::Script;
+			else if(file == "ItemList.json")
+				change.kind = AssetKind::ItemList;
+			else
+				continue;
+
+			if(std::find(pending.begin(), pending.end(), change) == pending.end())
+				pending.push_back(std::move(change));
+		}
+	}
+#endif
+}
+
+unsigned HotReload::poll() {
+	PROFILE_SCOPE("Hot reload");
+	auto& reload = get();
+	if(reload.inotifyFd < 0) return 0;
+
+	reload.readEvents();
+	if(reload.pending.empty()) return 0;
+
+	unsigned reloaded = 0;
+	std::vector<AssetChange> deferred;
+	for(auto& change : reload.pending) {
+		switch(AssetManager::reloadAsset(change)) {
+			case ReloadResult::Reloaded:
+				std::cout << "HotReload/ Reloaded '" << change.path << "'\n";
+				++reloaded;
+				for(auto& listener : reload.listeners)
+					listener.second(change);
+				break;
+			case ReloadResult::Deferred:
+				deferred.push_back(std::move(change));
+				break;
+			case ReloadResult::Failed:
+				std::cerr << "HotReload/ Failed reloading '" << change.path << "', keeping the previous version\n";
+				break;
+		}
+	}
+	reload.pending = std::move(deferred);
+
+	return reloaded;
+}
+
+HotReload::ListenerID HotReload::subscribe(Listener listener) {
+	auto& reload = get();
+	const auto id = reload.nextListener++;
+	reload.listeners.emplace_back(id, std::move(listener));
+	return id;
+}
+
+void HotReload::unsubscribe(ListenerID id) {
+	auto& listeners = get().listeners;
+	listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [id](const std::pair<ListenerID, Listener>& l) {
+		return l.first == id;
+	}), listeners.end());
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ *      HotReload - przeładowywanie zasobów GameContent w trakcie działania gry i edytora
+ *  Zmiany plików zgłasza inotify (Linux), więc nie ma żadnego odpytywania dysku. poll() wołane jest raz
+ *  na klatkę z głównego wątku - zbiera zdarzenia, przeładowuje w miejscu tylko zmienione zasoby
+ *  (AssetManager::reloadAsset) i powiadamia subskrybentów, którzy trzymają dany zasób.
+ *  Obsługiwane są mapy, tilesety (obraz i konfiguracja), skrypty Lua oraz ItemList.json.
+ *  Gdy zasoby czytane są z paczki (GameContent.pack), śledzenie jest wyłączone.
+ */
+enum class AssetKind {
+	Map,
+	Tileset,
+	Script,
+	ItemList
+};
+
+struct AssetChange {
+	AssetKind kind;
+	std::string name;	//  nazwa zasobu, np. "default" dla GameContent/Map/default.json
+	std::string path;	//  ścieżka zmienionego pliku
+
+	bool operator==(const AssetChange& other) const { return kind == other.kind && path == other.path; }
+};
+
+enum class ReloadResult {
+	Reloaded,
+	Deferred,	//  zasób jest teraz w użyciu - ponowna próba w kolejnej klatce
+	Failed
+};
+
+class HotReload {
+public:
+	typedef std::function<void(const AssetChange&)> Listener;
+	typedef unsigned ListenerID;
+private:
+	int inotifyFd {-1};
+	std::vector<std::pair<int, std::string>> watches;	//  deskryptor inotify, katalog
+	std::vector<AssetChange> pending;
+	std::vector<std::pair<ListenerID, Listener>> listeners;
+	ListenerID nextListener {0};
+
+	static HotReload& get() {
+		static HotReload instance;
+		return instance;
+	}
+
+	HotReload() = default;
+	~HotReload();
+
+	bool watch(const std::string& directory);
+	void readEvents();
+	void close();
+public:
+	HotReload(const HotReload&) = delete;
+	HotReload& operator=(const HotReload&) = delete;
+
+	static bool start(const std::string& root = "GameContent");
+	static void stop();
+	static bool active() { return get().inotifyFd >= 0; }
+
+	/*
+	 *  Zwraca liczbę przeładowanych w tej klatce zasobów
+	 */
+	static unsigned poll();
+
+	static ListenerID subscribe(Listener listener);
+	static void unsubscribe(ListenerID id);
+};
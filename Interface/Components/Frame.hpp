@@ -1,10 +1,11 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "AssetManager.hpp"
+#include "Interface/Components/NineSlice.hpp"
 
 class Frame {
 protected:
-	sf::Sprite final;
+	NineSlice panel;
 	sf::Vector2f position, size;
 	bool focus;
 
@@ -15,8 +16,6 @@ public:
 	void Init(sf::Vector2f, sf::Vector2f);
 
 	void Draw(sf::RenderTarget&);
-	void DrawFrame(sf::RenderTarget&);
-	void DrawBackground(sf::RenderTarget&);
 
 	sf::Vector2f GetPosition() { return position; };
 	sf::Vector2f GetSize()     { return size; }
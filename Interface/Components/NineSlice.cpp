@@ -0,0 +1,120 @@
+#include "Interface/Components/NineSlice.hpp"
+
+NineSlice::NineSlice(const sf::Texture& tex, const NineSliceStyle& st)
+: texture(&tex), style(st) { }
+
+void NineSlice::setTexture(const sf::Texture& tex) {
+	texture = &tex;
+}
+
+void NineSlice::setStyle(const NineSliceStyle& st) {
+	if(style == st) return;
+	style = st;
+	dirty = true;
+}
+
+void NineSlice::setPosition(sf::Vector2f pos) {
+	if(position == pos) return;
+	position = pos;
+	dirty = true;
+}
+
+void NineSlice::setSize(sf::Vector2f siz) {
+	if(size == siz) return;
+	size = siz;
+	dirty = true;
+}
+
+void NineSlice::setColor(sf::Color col) {
+	if(color == col) return;
+	color = col;
+	dirty = true;
+}
+
+void NineSlice::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	if(!texture) return;
+
+	if(dirty) {
+		vertices.clear();
+		appendPanel(vertices, style, position, size, color);
+		dirty = false;
+	}
+
+	states.texture = texture;
+	target.draw(vertices, states);
+}
+
+void NineSlice::appendQuad(sf::VertexArray& array, sf::Vector2f pos, sf::Vector2f size, sf::IntRect src, sf::Color color) {
+	const sf::Vector2f tl((float)src.left, (float)src.top);
+	const sf::Vector2f br((float)(src.left + src.width), (float)(src.top + src.height));
+
+	array.append(sf::Vertex(pos, color, tl));
+	array.append(sf::Vertex(pos + sf::Vector2f(size.x, 0), color, sf::Vector2f(br.x, tl.y)));
+	array.append(sf::Vertex(pos + size, color, br));
+	array.append(sf::Vertex(pos + sf::Vector2f(0, size.y), color, sf::Vector2f(tl.x, br.y)));
+}
+
+/*
+ *  Dokłada panel do istniejącej tablicy wierzchołków - tło, a na nim cztery rogi i cztery krawędzie.
+ *  Środek ramki nie jest rysowany, jego miejsce zajmuje tło.
+ */
+void NineSlice::appendPanel(sf::VertexArray& array, const NineSliceStyle& style, sf::Vector2f pos, sf::Vector2f size, sf::Color color) {
+	if(style.background.width > 0) {
+		const sf::Vector2f inset(style.backgroundInset, style.backgroundInset);
+		appendQuad(array, pos + inset, size - inset * 2.0f, style.background, color);
+	}
+
+	if(style.border <= 0 || style.frame.width <= 0) return;
+
+	const int b = style.border;
+	const float fb = (float)b;
+	const auto& f = style.frame;
+	const int innerW = f.width - 2 * b;
+	const int innerH = f.height - 2 * b;
+	const sf::Vector2f inner(size.x - 2 * fb, size.y - 2 * fb);
+
+	//Corners
+	appendQuad(array, pos, {fb, fb}, sf::IntRect(f.left, f.top, b, b), color);
+	appendQuad(array, pos + sf::Vector2f(size.x - fb, 0), {fb, fb}, sf::IntRect(f.left + f.width - b, f.top, b, b), color);
+	appendQuad(array, pos + sf::Vector2f(0, size.y - fb), {fb, fb}, sf::IntRect(f.left, f.top + f.height - b, b, b), color);
+	appendQuad(array, pos + size - sf::Vector2f(fb, fb), {fb, fb}, sf::IntRect(f.left + f.width - b, f.top + f.height - b, b, b), color);
+
+	//Edges
+	appendQuad(array, pos + sf::Vector2f(fb, 0), {inner.x, fb}, sf::IntRect(f.left + b, f.top, innerW, b), color);
+	appendQuad(array, pos + sf::Vector2f(fb, size.y - fb), {inner.x, fb}, sf::IntRect(f.left + b, f.top + f.height - b, innerW, b), color);
+	appendQuad(array, pos + sf::Vector2f(0, fb), {fb, inner.y}, sf::IntRect(f.left, f.top + b, b, innerH), color);
+	appendQuad(array, pos + sf::Vector2f(size.x - fb, fb), {fb, inner.y}, sf::IntRect(f.left + f.width - b, f.top + b, b, innerH), color);
+}
+
+/*
+ *  Okno ze skórki windowskin - ramka 128x128 z rogami 16px, tło 64x64 obok niej
+ */
+NineSliceStyle NineSlice::windowStyle() {
+	NineSliceStyle style;
+	style.frame = sf::IntRect(0, 0, 128, 128);
+	style.border = 16;
+	style.background = sf::IntRect(128, 0, 64, 64);
+	style.backgroundInset = 2.0f;
+	return style;
+}
+
+/*
+ *  Komórka (Frame) - ramka 1px wokół tła 30x30, wersja z fokusem przesunięta o 32px w prawo
+ */
+NineSliceStyle NineSlice::frameStyle(bool focused) {
+	const int x = focused ? 160 : 128;
+	NineSliceStyle style;
+	style.frame = sf::IntRect(x, 64, 32, 32);
+	style.border = 1;
+	style.background = sf::IntRect(x + 1, 65, 30, 30);
+	return style;
+}
+
+/*
+ *  Jednolity prostokąt rozciągany na cały panel (RawWindow)
+ */
+NineSliceStyle NineSlice::rawStyle(sf::IntRect area) {
+	NineSliceStyle style;
+	style.background = area;
+	return style;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+/*
+ *      NineSliceStyle - opis panelu w teksturze skórki okna
+ *  frame to obszar ramki (rogi + krawędzie) o grubości border, background to tło rozciągane
+ *  pod ramką z marginesem backgroundInset. Puste prostokąty (szerokość 0) są pomijane.
+ */
+struct NineSliceStyle {
+	sf::IntRect frame {};
+	int border {0};
+	sf::IntRect background {};
+	float backgroundInset {0.0f};
+
+	bool operator==(const NineSliceStyle& other) const {
+		return frame == other.frame && border == other.border
+		       && background == other.background && backgroundInset == other.backgroundInset;
+	}
+	bool operator!=(const NineSliceStyle& other) const { return !(*this == other); }
+};
+
+/*
+ *      NineSlice - panel UI rysowany jednym wywołaniem draw
+ *  Geometria (tło, rogi, rozciągnięte krawędzie) trzymana jest w jednej tablicy wierzchołków
+ *  i przebudowywana tylko wtedy, gdy zmieni się pozycja, rozmiar, styl lub kolor.
+ */
+class NineSlice : public sf::Drawable {
+	const sf::Texture* texture {nullptr};
+	NineSliceStyle style;
+	sf::Vector2f position, size;
+	sf::Color color {sf::Color::White};
+
+	mutable sf::VertexArray vertices {sf::Quads};
+	mutable bool dirty {true};
+
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+public:
+	NineSlice() = default;
+	NineSlice(const sf::Texture& texture, const NineSliceStyle& style);
+
+	void setTexture(const sf::Texture& tex);
+	void setStyle(const NineSliceStyle& st);
+	void setPosition(sf::Vector2f pos);
+	void setSize(sf::Vector2f siz);
+	void setColor(sf::Color col);
+
+	const sf::Color& getColor() const { return color; }
+
+	static void appendQuad(sf::VertexArray& array, sf::Vector2f pos, sf::Vector2f size, sf::IntRect src, sf::Color color = sf::Color::White);
+	static void appendPanel(sf::VertexArray& array, const NineSliceStyle& style, sf::Vector2f pos, sf::Vector2f size, sf::Color color = sf::Color::White);
+
+	//  Style skórek używanych w grze
+	static NineSliceStyle windowStyle();
+	static NineSliceStyle frameStyle(bool focused);
+	static NineSliceStyle rawStyle(sf::IntRect area);
+};
@@ -15,13 +15,13 @@ void RawWindow::Init(sf::Vector2f p, sf::Vector2f s, std::string n, int fontsize
 }
 
 void RawWindow::SetWindowSkin(std::string name) {
-	final.setTexture(AssetManager::getUI(name).getTexture());
+	panel.setTexture(AssetManager::getUI(name).getTexture());
+	panel.setStyle(NineSlice::rawStyle(sf::IntRect(0, 0, 128, 64)));
 }
 
 void RawWindow::Draw(sf::RenderTarget& target) {
-	final.setTextureRect(sf::IntRect(0, 0, 128, 64));
-	final.setPosition(position);
-	final.setScale((size.x) / 128, (size.y) / 64);
-	target.draw(final);
+	panel.setPosition(position);
+	panel.setSize(size);
+	target.draw(panel);
 	this->DrawSelf(target);
 }
\ No newline at end of file
@@ -1,10 +1,11 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "AssetManager.hpp"
+#include "Interface/Components/NineSlice.hpp"
 
 class RawWindow {	//Without frame
 protected:
-	sf::Sprite final;
+	NineSlice panel;
 	sf::Vector2f position, size;
 	const sf::Font& font;
 	virtual void DrawSelf(sf::RenderTarget&) { }
@@ -1,12 +1,13 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "AssetManager.hpp"
+#include "Interface/Components/NineSlice.hpp"
 
 class Window {
 protected:
-	sf::Sprite final;
+	NineSlice panel;
 	sf::Vector2f position, size;
-	sf::Font font;
+	const sf::Font& font;
 	virtual void DrawSelf(sf::RenderTarget&) { }
 	virtual void SelfInit() { }
 public:
@@ -14,8 +15,6 @@ public:
 	~Window();
 	void Init(sf::Vector2f, sf::Vector2f);
 	void Draw(sf::RenderTarget&);
-	void DrawBackground(sf::RenderTarget&);
-	void DrawFrame(sf::RenderTarget&);
 	void setPosition(sf::Vector2f pos) { position = pos; }
 	void setSize(sf::Vector2f siz) { size = siz; }
 	void setTint(sf::Color);
@@ -1,12 +1,14 @@
+#include <algorithm>
 #include <cassert>
 #include "DialogEngine.hpp"
 #include "Entity/Script.hpp"
 #include "OptionWindow.hpp"
+#include "Profiler.hpp"
 
 DialogEngine* DialogEngine::instance = nullptr;
 
 DialogEngine::DialogEngine()
-: font(AssetManager::getFont("VCR_OSD_MONO")){
+: font(AssetManager::getFont("VCR_OSD_MONO")), revealed(0), layoutValid(false) {
 
 	instance = this;
 	selection = 0;
@@ -14,71 +16,187 @@ DialogEngine::DialogEngine()
 
 void DialogEngine::spawnDialog(const Dialog& dialog) {
 	dialogBoxes.push_back(dialog);
+	if(dialogBoxes.size() == 1) {
+		layoutValid = false;
+		if(layoutViewSize.x > 0 && layoutViewSize.y > 0)
+			buildLayout(dialogBoxes.front());
+	}
 }
 
 void DialogEngine::update() {
+	PROFILE_SCOPE("Dialog update");
+	if(!this->isDialogPresent() || !layoutValid || fullyRevealed()) return;
 
+	revealed = std::min<unsigned>(revealed + revealSpeed, wrappedText.getSize());
+	dialogText.setString(wrappedText.substring(0, revealed));
 }
 
-void DialogEngine::draw(sf::RenderTarget &target) {
-	if(!this->isDialogPresent()) return;
+/*
+ *  Zawija tekst na granicach słów tak, by żadna linia nie przekraczała maxWidth.
+ *  Słowa dłuższe niż cała linia łamane są w dowolnym miejscu.
+ */
+sf::String DialogEngine::wrapText(const std::string& text, const sf::Font& font, unsigned size, float maxWidth) {
+	const sf::String source = sf::String::fromUtf8(text.begin(), text.end());
+	sf::String result;
+
+	auto advance = [&](sf::Uint32 prev, sf::Uint32 cur) {
+		return font.getGlyph(cur, size, false).advance + (prev ? font.getKerning(prev, cur, size) : 0.0f);
+	};
+
+	float lineWidth = 0.0f;
+	std::size_t i = 0;
+	while(i < source.getSize()) {
+		const sf::Uint32 c = source[i];
+		if(c == '\n') {
+			result += c;
+			lineWidth = 0.0f;
+			++i;
+			continue;
+		}
+		if(c == ' ') {
+			const float w = advance(0, c);
+			if(lineWidth + w <= maxWidth) {
+				result += c;
+				lineWidth += w;
+			}
+			++i;
+			continue;
+		}
 
-	Dialog dialog = dialogBoxes.front();
+		//  Słowo - do najbliższej spacji lub końca linii
+		std::size_t end = i;
+		float wordWidth = 0.0f;
+		while(end < source.getSize() && source[end] != ' ' && source[end] != '\n') {
+			wordWidth += advance(end > i ? source[end - 1] : 0, source[end]);
+			++end;
+		}
 
-	Window dialogWindow;
-	sf::Vector2f windowSize = target.getView().getSize();
-	int ChoicesNum = dialog.getChoices().size();
+		if(lineWidth > 0.0f && lineWidth + wordWidth > maxWidth) {
+			//  Usunięcie spacji wiszącej na końcu linii
+			if(!result.isEmpty() && result[result.getSize() - 1] == ' ')
+				result.erase(result.getSize() - 1);
+			result += '\n';
+			lineWidth = 0.0f;
+		}
+
+		for(std::size_t j = i; j < end; ++j) {
+			const float w = advance(j > i ? source[j - 1] : 0, source[j]);
+			if(lineWidth > 0.0f && lineWidth + w > maxWidth) {
+				result += '\n';
+				lineWidth = 0.0f;
+			}
+			result += source[j];
+			lineWidth += w;
+		}
+		i = end;
+	}
+	return result;
+}
+
+void DialogEngine::buildLayout(const Dialog& dialog) {
+	const sf::Vector2f windowSize = layoutViewSize;
+	const int ChoicesNum = dialog.getChoices().size();
 
 	Vec2f instance_position;
 	Vec2f instance_size;
+	Vec2f text_box;
 
 	if(dialog.getDialogType() == Dialog_Choice) {
-		int i = 0;
 		instance_size = sf::Vector2f((windowSize.x / 1.2), (ChoicesNum * 52 + 16));
-		instance_position = sf::Vector2f(((windowSize.x - instance_size.x) / 2), (windowSize.y - instance_size.y - 16) );
-		dialogWindow.Init(instance_position, sf::Vector2f(instance_size.x / 1.5, instance_size.y));
-		for(auto& choice : dialog.getChoices()) {
-			OptionWindow choiceWindow;
-			Vec2f selfSize{ (float)(instance_size.x - (instance_size.x / 1.5) + 4), 64.0 };
+		text_box = sf::Vector2f(instance_size.x / 1.5, instance_size.y);
+	} else {
+		instance_size = sf::Vector2f((windowSize.x / 1.2), (windowSize.y / 4 + 16) );
+		text_box = instance_size;
+	}
 
-			if (i == selection) choiceWindow.SetFocus();
-			else choiceWindow.RemoveFocus();
+	wrappedText = wrapText(dialog.getText(), font, characterSize, text_box.x - 20.0f);
 
-			choiceWindow.Init(instance_position + sf::Vector2f(instance_size.x / 1.5, 52 * i++), selfSize, "quote_window", 24);
-			choiceWindow.SetMessage(choice);
-			choiceWindow.Draw(target);
-		}
+	//  Długie monologi powiększają okno w górę zamiast wychodzić poza nie
+	unsigned lines = 1;
+	for(auto c : wrappedText) if(c == '\n') ++lines;
+	const float text_height = lines * font.getLineSpacing(characterSize) + 15.0f;
+	if(text_height > text_box.y) {
+		text_box.y = text_height;
+		instance_size.y = std::max(instance_size.y, text_height);
 	}
-	else {
-		instance_size = sf::Vector2f((windowSize.x / 1.2), (windowSize.y / 4 + 16) );
-		instance_position = sf::Vector2f(((windowSize.x - instance_size.x) / 2), (windowSize.y - instance_size.y - 16));
-		dialogWindow.Init(instance_position, instance_size);
+
+	instance_position = sf::Vector2f(((windowSize.x - instance_size.x) / 2), (windowSize.y - instance_size.y - 16));
+	dialogWindow.Init(instance_position, text_box);
+
+	choiceWindows.resize(ChoicesNum);
+	for(int i = 0; i < ChoicesNum; ++i) {
+		Vec2f selfSize{ (float)(instance_size.x - (instance_size.x / 1.5) + 4), 64.0 };
+		choiceWindows[i].Init(instance_position + sf::Vector2f(instance_size.x / 1.5, 52 * i), selfSize, "quote_window", 24);
+		choiceWindows[i].SetMessage(dialog.getChoices()[i]);
 	}
+	updateSelection();
 
-	dialogWindow.Draw(target);
+	dialogText = sf::Text(wrappedText, font, characterSize);
+	AssetManager::trackGlyphs(dialogText);
+	dialogText.setString(wrappedText.substring(0, revealed));
+	dialogText.setPosition(instance_position + Vec2f{10.0, 5.0});
+
+	layoutValid = true;
+}
+
+void DialogEngine::updateSelection() {
+	for(unsigned i = 0; i < choiceWindows.size(); ++i) {
+		if (i == selection) choiceWindows[i].SetFocus();
+		else choiceWindows[i].RemoveFocus();
+	}
+}
+
+void DialogEngine::draw(sf::RenderTarget &target) {
+	PROFILE_SCOPE("Dialog draw");
+	if(!this->isDialogPresent()) return;
 
-	sf::Text text{dialog.getText(), font, 30};
-	text.setPosition(instance_position + Vec2f{10.0, 5.0});
-	target.draw(text);
+	if(!layoutValid || layoutViewSize != target.getView().getSize()) {
+		layoutViewSize = target.getView().getSize();
+		buildLayout(dialogBoxes.front());
+	}
+
+	if(dialogBoxes.front().getDialogType() == Dialog_Choice) {
+		for(auto& choiceWindow : choiceWindows)
+			choiceWindow.Draw(target);
+	}
+
+	dialogWindow.Draw(target);
+	target.draw(dialogText);
 }
 
 void DialogEngine::handleKeyEvent(sf::Event::KeyEvent &event) {
 	if(!this->isDialogPresent()) return;
 
-	Dialog dialog = dialogBoxes.front();
+	const Dialog& dialog = dialogBoxes.front();
 	if(event.code == sf::Keyboard::Space) {
-		dialogBoxes.pop_front();
+		//  Pierwsze naciśnięcie kończy animację pisania, drugie zamyka dialog
+		if(layoutValid && !fullyRevealed()) {
+			revealed = wrappedText.getSize();
+			dialogText.setString(wrappedText);
+			return;
+		}
 
-		if(dialog.getOwner()) dialog.getOwner()->resumePausedCoroutine();
+		Script* owner = dialog.getOwner();
+		dialogBoxes.pop_front();
+		revealed = 0;
+		layoutValid = false;
+
+		//  Skrypt odczytuje odpowiedź (dialog.choice) po wznowieniu - wybór zerowany dopiero potem
+		if(owner) owner->resumePausedCoroutine();
+		selection = 0;
+		if(this->isDialogPresent())
+			buildLayout(dialogBoxes.front());
 	} else if (event.code == sf::Keyboard::S) {
 		if(dialog.getDialogType() != Dialog_Choice) return;
 
 		if(selection == dialog.getChoices().size() - 1) selection = 0;
 		else selection++;
+		updateSelection();
 	} else if (event.code == sf::Keyboard::W) {
 		if(dialog.getDialogType() != Dialog_Choice) return;
 
 		if(selection == 0) selection = dialog.getChoices().size() - 1;
 		else selection--;
+		updateSelection();
 	}
 }
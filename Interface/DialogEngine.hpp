@@ -4,6 +4,7 @@
 #include <SFML/Graphics.hpp>
 #include "Interface/Components/Window.hpp"
 #include "Interface/Components/Button.hpp"
+#include "Interface/OptionWindow.hpp"
 #include "Dialog.hpp"
 #include <sol/forward.hpp>
 
@@ -12,7 +13,25 @@ class DialogEngine {
 
 	std::deque<Dialog> dialogBoxes;
 	unsigned selection;
-	sf::Font font;
+	const sf::Font& font;
+
+	Window dialogWindow;
+	std::vector<OptionWindow> choiceWindows;
+
+	//  Układ aktualnie wyświetlanego dialogu - budowany raz, gdy dialog trafia na początek kolejki
+	sf::Text dialogText;
+	sf::String wrappedText;
+	unsigned revealed;
+	bool layoutValid;
+	sf::Vector2f layoutViewSize;
+
+	static const unsigned characterSize = 30;
+	static const unsigned revealSpeed = 2;	//znaki na klatkę
+
+	void buildLayout(const Dialog& dialog);
+	void updateSelection();
+	bool fullyRevealed() const { return revealed >= wrappedText.getSize(); }
+	static sf::String wrapText(const std::string& text, const sf::Font& font, unsigned size, float maxWidth);
 public:
 	DialogEngine();
 
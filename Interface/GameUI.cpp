@@ -1,4 +1,5 @@
 #include "GameUI.hpp"
+#include "Profiler.hpp"
 
 GameUI::GameUI(Player& _player)
 : player(_player), eq(_player), hud(_player, sf::Vector2f(8,8)), resolution(std::pair(800,600)) {
@@ -14,6 +15,7 @@ void GameUI::Init(std::shared_ptr<sf::RenderWindow> win) {
 }
 
 void GameUI::DrawGUI(sf::RenderTarget& target) {
+	PROFILE_SCOPE("GUI draw");
 	sf::Vector2f cred_pos((target.getView().getSize().x - 400) / 2, 250);
 	credits.setPosition(cred_pos);
 	settings.setPosition(sf::Vector2f((resolution.first - 300) / 2, (resolution.second - 400) / 2));
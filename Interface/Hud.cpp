@@ -17,55 +17,75 @@ void Hud::Init() {
 	exp_size = sf::Vector2f(52, 101);
 	bars_size = sf::Vector2f(287,8);
 	main_section_size = sf::Vector2f(120, 120);
+
+	//Cache - the view keeps screen coordinates, so the HUD is laid out exactly as before
+	cache.create((unsigned)size.x, (unsigned)size.y);
+	cache.setView(sf::View(sf::FloatRect(position.x, position.y, size.x, size.y)));
+	cached.setTexture(cache.getTexture(), true);
+	cached.setPosition(position);
+	cacheValid = false;
 }
 
 void Hud::Draw(sf::RenderTarget& target) {
 	if (player.getWorldPosition().x > 12 or player.getWorldPosition().y > 3) {	//Hide HUD if player is obscured
+		if (!cacheValid or cachedRevision != player.getStatsRevision())
+			Redraw();
 
-		//Draw Base
-		target.draw(base);
-
-		//Calculate shifts
-		float shiftHP = bars_size.x * (player.getStatistics()["HP"] / double(player.getStatistics()["MaxHP"]));
-		float shiftMP = bars_size.x * (player.getStatistics()["MP"] / double(player.getStatistics()["MaxMP"]));
-		float shiftExp = (player.getPlayerInfo()["current"] / double(player.getPlayerInfo()["next"]));
-
-		//Draw HP Baar
-		hp.setTextureRect(sf::IntRect(0, 0, shiftHP, 8));
-		target.draw(hp);
-
-		//Draw MP Bar
-		mp.setTextureRect(sf::IntRect(0, 0, shiftMP, 8));
-		target.draw(mp);
-
-		//Cut and draw Exp Bar
-		exp.setTextureRect(sf::IntRect(0, exp_size.y - exp_size.y *shiftExp, exp_size.x, exp_size.y *shiftExp));
-		exp.setPosition(position + sf::Vector2f(0, exp_size.y - exp_size.y * shiftExp) + sf::Vector2f(3, 9));
-		target.draw(exp);
-
-		//Make dynamic texts
-		sf::Text hp_val = ParseStatistic("", player.getStatistics()["HP"], "/", player.getStatistics()["MaxHP"], "", 16);
-		sf::Text mp_val = ParseStatistic("", player.getStatistics()["MP"], "/", player.getStatistics()["MaxMP"], "", 16);
-		sf::Text lvl_val = ParseStatistic(" ", player.getPlayerInfo()["lvl"], " ", 28);
-		sf::Text exp_val = ParseStatistic(" ", shiftExp * 100, " %", 16);
-		sf::Text gold_val = ParseStatistic("", player.getPlayerInfo()["gold"], "", 16);
-
-		//Get their positions
-		sf::Vector2f hp_text_pos = getOffset(hp_val, bars_size, hp.getPosition() - sf::Vector2f(0,1));
-		sf::Vector2f mp_text_pos = getOffset(mp_val, bars_size, mp.getPosition() - sf::Vector2f(0,1));
-		sf::Vector2f lvl_text_pos = getOffset(lvl_val, main_section_size, sf::Vector2f(0, -main_section_size.y / 12));
-		sf::Vector2f exp_text_pos = getOffset(exp_val, main_section_size, sf::Vector2f(0, main_section_size.y / 6));
-		sf::Vector2f gold_text_pos = getOffset(gold_val, sf::Vector2f(0,0), position + sf::Vector2f(132, 94));
-
-		//Draw dynamic values
-		DrawLine(target, hp_text_pos, hp_val);
-		DrawLine(target, mp_text_pos, mp_val);
-		DrawLine(target, lvl_text_pos, lvl_val);
-		DrawLine(target, exp_text_pos, exp_val);
-		DrawLine(target, gold_text_pos, gold_val);
+		target.draw(cached);
 	}
 }
 
+void Hud::Redraw() {
+	sf::RenderTexture& target = cache;
+	target.clear(sf::Color::Transparent);
+
+	//Draw Base
+	target.draw(base);
+
+	//Calculate shifts
+	float shiftHP = bars_size.x * (player.getStat("HP") / double(player.getStat("MaxHP")));
+	float shiftMP = bars_size.x * (player.getStat("MP") / double(player.getStat("MaxMP")));
+	float shiftExp = (player.getInfo("current") / double(player.getInfo("next")));
+
+	//Draw HP Baar
+	hp.setTextureRect(sf::IntRect(0, 0, shiftHP, 8));
+	target.draw(hp);
+
+	//Draw MP Bar
+	mp.setTextureRect(sf::IntRect(0, 0, shiftMP, 8));
+	target.draw(mp);
+
+	//Cut and draw Exp Bar
+	exp.setTextureRect(sf::IntRect(0, exp_size.y - exp_size.y *shiftExp, exp_size.x, exp_size.y *shiftExp));
+	exp.setPosition(position + sf::Vector2f(0, exp_size.y - exp_size.y * shiftExp) + sf::Vector2f(3, 9));
+	target.draw(exp);
+
+	//Make dynamic texts
+	sf::Text hp_val = ParseStatistic("", player.getStat("HP"), "/", player.getStat("MaxHP"), "", 16);
+	sf::Text mp_val = ParseStatistic("", player.getStat("MP"), "/", player.getStat("MaxMP"), "", 16);
+	sf::Text lvl_val = ParseStatistic(" ", player.getInfo("lvl"), " ", 28);
+	sf::Text exp_val = ParseStatistic(" ", shiftExp * 100, " %", 16);
+	sf::Text gold_val = ParseStatistic("", player.getInfo("gold"), "", 16);
+
+	//Get their positions
+	sf::Vector2f hp_text_pos = getOffset(hp_val, bars_size, hp.getPosition() - sf::Vector2f(0,1));
+	sf::Vector2f mp_text_pos = getOffset(mp_val, bars_size, mp.getPosition() - sf::Vector2f(0,1));
+	sf::Vector2f lvl_text_pos = getOffset(lvl_val, main_section_size, sf::Vector2f(0, -main_section_size.y / 12));
+	sf::Vector2f exp_text_pos = getOffset(exp_val, main_section_size, sf::Vector2f(0, main_section_size.y / 6));
+	sf::Vector2f gold_text_pos = getOffset(gold_val, sf::Vector2f(0,0), position + sf::Vector2f(132, 94));
+
+	//Draw dynamic values
+	DrawLine(target, hp_text_pos, hp_val);
+	DrawLine(target, mp_text_pos, mp_val);
+	DrawLine(target, lvl_text_pos, lvl_val);
+	DrawLine(target, exp_text_pos, exp_val);
+	DrawLine(target, gold_text_pos, gold_val);
+
+	target.display();
+	cachedRevision = player.getStatsRevision();
+	cacheValid = true;
+}
+
 sf::Text Hud::ParseStatistic(std::string prefix, int value1, std::string separator, int value2, std::string sufix, int fontSize) {
 	//Parse format: PREFIX VALUE SEPARATOR VALUE2 SUFIX, f.e. Life: 34 / 100 %
 	std::string line = prefix + std::to_string(value1) + separator + std::to_string(value2) + sufix;
@@ -83,6 +103,7 @@ void Hud::DrawLine(sf::RenderTarget& target, sf::Vector2f position, sf::Text tex
 	text.setFont(font);
 	text.setColor(sf::Color::White);
 	text.setPosition(position);
+	AssetManager::trackGlyphs(text);	//Only from Redraw - once per stats change
 	target.draw(text);
 }
 
@@ -4,6 +4,11 @@
 #include "Graphics/Spritesheet.hpp"
 #include "Entity/Player.hpp"
 
+/*
+ *      Hud - pasek zdrowia, many, doświadczenia i złota
+ *  Zawartość renderowana jest do tekstury (cache) i odświeżana tylko wtedy, gdy zmieni się
+ *  licznik zmian statystyk gracza. W pozostałych klatkach HUD to jeden sprite.
+ */
 class Hud {
 private:
 	const sf::Font& font;
@@ -11,10 +16,18 @@ private:
 	sf::Vector2f position, size;
 	Player& player;
 
+	//Cached render
+	sf::RenderTexture cache;
+	sf::Sprite cached;
+	unsigned cachedRevision;
+	bool cacheValid;
+
 	//Static values to dynamic calculate
 	sf::Vector2f exp_size, bars_size, main_section_size;
+
+	void Redraw();
 public:
-	Hud(Player& entity, sf::Vector2f offset) : player(entity), position(offset), font(AssetManager::getFont("VCR_OSD_MONO")) {};
+	Hud(Player& entity, sf::Vector2f offset) : player(entity), position(offset), font(AssetManager::getFont("VCR_OSD_MONO")), cachedRevision(0), cacheValid(false) {};
 
 	void Init();
 	void Draw(sf::RenderTarget&);
@@ -25,4 +38,4 @@ public:
 
 	sf::Vector2f getTextSize(sf::Text);
 	sf::Vector2f getOffset(sf::Text, sf::Vector2f, sf::Vector2f = sf::Vector2f(0,0));
-};
\ No newline at end of file
+};
@@ -1,22 +1,23 @@
 #include "Cell.hpp"
 
-Cell::Cell() : item(nullptr), empty(true), Frame() { }
-Cell::Cell(const std::shared_ptr<Item>& _item) : item(_item), empty(_item), Frame() { }
+Cell::Cell() : item(), Frame() { }
+Cell::Cell(const ItemSlot& _item) : item(_item), Frame() { }
 
 void Cell::SelfInit() {
 	
 }
 
 void Cell::SelfDraw(sf::RenderTarget& target) {
-	if (item != nullptr) {
-		item->draw(target, position);
+	if (!item.empty()) {
+		item.toItem().draw(target, position);
 	}
-	if (item != nullptr && item->getMaxStack() != 1) {
+	if (!item.empty() && item.getDefinition().maxStack != 1) {
 		unsigned counterSize = 10;
 		auto offset = Vec2f{ 2.0, 2.0 };
 
-		auto& font = AssetManager::getFont("ConnectionSerif");
-		std::string count = std::to_string(item->getStack());
+		static const FontHandle counterFont = AssetManager::findFont("ConnectionSerif");
+		auto& font = AssetManager::getFont(counterFont);
+		std::string count = std::to_string(item.count);
 
 		sf::Text itemCount;
 		itemCount.setFont(font);
@@ -7,16 +7,15 @@
 
 class Cell : public Frame {
 protected:
-	std::shared_ptr<Item> item;
-	bool empty;
+	ItemSlot item;
 
 	void SelfDraw(sf::RenderTarget&)override;
 	void SelfInit()override;
 public:
 	Cell();
-	Cell(const std::shared_ptr<Item>& _item);
+	Cell(const ItemSlot& _item);
 
-	std::shared_ptr<Item> getItem() { return item; };
-	bool isEmpty() { return empty; };
+	const ItemSlot& getItem() { return item; };
+	bool isEmpty() { return item.empty(); };
 	//string Info() { return temporary; }	//'Return Item info to subwindow'
 };
\ No newline at end of file
@@ -1,7 +1,23 @@
 #include "InvUI.hpp"
 
+//Statistic names displayed in the character panel, indexed like the statistic keys
+static const std::vector<std::string> s_stat_names{ "Life",				"",
+										"Mana",				"",
+										"Melee damage",
+										"Fire damage",
+										"Water damage",
+										"Lightning damage",
+										"Attack speed",
+										"Armor",
+										"Resistance",
+										"Critical",
+										"Dodge",
+};
+
 InvUI::InvUI(Player& entity)
-: player(entity), statistics(entity.getStatistics()), player_info(entity.getPlayerInfo()), inventory(entity.getInventory()), equipment(inventory.getEquipment()), font(AssetManager::getFont("VCR_OSD_MONO")), sec_focus(section::INVENTORY)
+: player(entity), inventory(entity.getInventory()), equipment(inventory.getEquipment()), font(AssetManager::getFont("VCR_OSD_MONO")), sec_focus(section::INVENTORY),
+  grid_cells(sf::Quads), grid_items(sf::Quads), grid_legend(sf::Quads), grid_valid(false), grid_revision(0), grid_focus(0), grid_section(section::INVENTORY),
+  grid_skin(AssetManager::findUI("windowskin")), grid_sheet(AssetManager::findUI("ItemList")), grid_eq_back(AssetManager::findUI("eq_back"))
 {
 
 }
@@ -9,17 +25,16 @@ InvUI::InvUI(Player& entity)
 void InvUI::DrawSelf(sf::RenderTarget& target) {
 	//Draw Content
 	DrawSeparator(target);
-	DrawInventory(target);
-	DrawEquipment(target);
+	DrawGrid(target);
 	DrawActorFace(target, position + sf::Vector2f(16, 32), sf::Vector2f(97,97));
 	DrawPlayerInfo(target, position + sf::Vector2f(120, 32), 18);
 	DrawStatistics(target, position + sf::Vector2f(16, 160), 16);
 
 	//Draw Ghost while moving item
 	sf::Vector2f ghost_pos;
-	if (subWin and subWin->MovFlag() and to_move) {
+	if (subWin and subWin->MovFlag() and to_move.valid() and !to_move.get().empty()) {
 		ghost_pos = focusCellPos + sf::Vector2f(5, 5);
-		to_move->draw(target, ghost_pos, sf::Color(255, 255, 255, 200));
+		to_move.get().toItem().draw(target, ghost_pos, sf::Color(255, 255, 255, 200));
 	}
 
 	//Dynamic titles
@@ -54,33 +69,117 @@ void InvUI::SelfInit() {
 	title_char = sf::Text("Character", font, 21);
 	title_char.setFillColor(sf::Color::White);
 
+	//Glyph tracking - character panel texts are rebuilt every frame, so their character set is registered once here
+	const std::string values = "0123456789-/%";
+	AssetManager::trackGlyphs(sf::Text(player.getName(), font, 19));
+	AssetManager::trackGlyphs(sf::Text("level " + values, font, 16));
+	AssetManager::trackGlyphs(sf::Text("EXP: " + values, font, 14));
+	for (const auto& statName : s_stat_names)
+		AssetManager::trackGlyphs(sf::Text(statName + ": ", font, 16));
+
 	//Other - flags
 	focus = 0;
 	sub = false;
 }
 
-void InvUI::DrawInventory(sf::RenderTarget& target) {
+/*
+ *  Siatka plecaka i ekwipunku przebudowywana jest tylko wtedy, gdy zmieniła się zawartość
+ *  (licznik zmian PlayerInventory), fokus lub pozycja okna
+ */
+bool InvUI::GridOutdated() const {
+	return !grid_valid
+	       || grid_revision != inventory.getRevision()
+	       || grid_focus != focus
+	       || grid_section != sec_focus
+	       || grid_position != position;
+}
+
+void InvUI::DrawGrid(sf::RenderTarget& target) {
+	if (GridOutdated()) RebuildGrid();
+
+	target.draw(grid_cells, &AssetManager::getSpritesheet(grid_skin).getTexture());
+	target.draw(grid_items, &AssetManager::getSpritesheet(grid_sheet).getTexture());
+	target.draw(grid_legend, &AssetManager::getSpritesheet(grid_eq_back).getTexture());
+	for (auto& text : grid_counts)
+		target.draw(text);
+}
+
+void InvUI::RebuildGrid() {
+	grid_cells.clear();
+	grid_items.clear();
+	grid_legend.clear();
+	grid_counts.clear();
+
 	sf::Vector2f cell_size(32, 32);
 	double offset_x = position.x + (size.x / 2.0) + ((size.x / 2.0) - 256.0) / 2.0;
-	double offset_y = position.y + (size.y / 3.0);
-	sf::Vector2f inventory_offset(offset_x, offset_y);
 
+	//Inventory
+	sf::Vector2f inventory_offset(offset_x, position.y + (size.y / 3.0));
 	unsigned i = 0;
-	//  Przelatujemy przez wszystkie wskaźniki na itemki w backpacku
-	for(auto& item : inventory.getBackpack()) {
-		Cell itemCell {item};
-		itemCell.Init(inventory_offset + sf::Vector2f((i % 8 * 32), (i / 8 * 32)), cell_size);
-
-		if (sec_focus == INVENTORY and i == focus) {
-			itemCell.SetFocus();
-			focusCellPos = itemCell.GetPosition();
-		}
-		else itemCell.RemoveFocus();
-
-		itemCell.Draw(target);
+	for (auto& item : inventory.getBackpack()) {
+		sf::Vector2f cell_pos = inventory_offset + sf::Vector2f((i % 8 * 32), (i / 8 * 32));
+		bool focused = (sec_focus == INVENTORY and i == focus);
+		if (focused) focusCellPos = cell_pos;
 
+		AppendCell(item, cell_pos, cell_size, focused);
 		++i;
 	}
+
+	//Equipment
+	sf::Vector2f equipment_offset(offset_x, position.y + 44);
+	for (unsigned int index = 0; index < (unsigned int)EquipmentSlot::_DummyEnd; index++) {
+		const auto& item = equipment.getEquipmentBySlot((EquipmentSlot)index);
+		bool focused = (sec_focus == EQUIPMENT and focus == index);
+		if (focused) focusCellPos = equipment_offset;
+
+		AppendCell(item, equipment_offset, cell_size, focused);
+		if (item.empty())
+			NineSlice::appendQuad(grid_legend, equipment_offset, cell_size, sf::IntRect(index * 32, 0, cell_size.x, cell_size.y), sf::Color(255, 255, 255, 160));
+
+		equipment_offset += sf::Vector2f(32, 0);
+	}
+
+	grid_valid = true;
+	grid_revision = inventory.getRevision();
+	grid_focus = focus;
+	grid_section = sec_focus;
+	grid_position = position;
+}
+
+/*
+ *  Odpowiednik Cell::Draw - tło, ramka, ikona przedmiotu oraz licznik stacka
+ */
+void InvUI::AppendCell(const ItemSlot& item, sf::Vector2f pos, sf::Vector2f cell_size, bool focused) {
+	//Background and frame (Frame draws its 1px border outside the cell)
+	NineSlice::appendPanel(grid_cells, NineSlice::frameStyle(focused), pos, cell_size + sf::Vector2f(1, 1));
+
+	if (item.empty()) return;
+
+	//Item icon
+	const auto& def = item.getDefinition();
+	auto& itemSheet = AssetManager::getSpritesheet(grid_sheet);
+	auto spriteSize = itemSheet.getSpriteSize();
+	NineSlice::appendQuad(grid_items, pos, sf::Vector2f(spriteSize.x, spriteSize.y), itemSheet.getTextureCoordinates(def.itemSprite));
+
+	//Stack counter
+	if (def.maxStack != 1) {
+		unsigned counterSize = 10;
+		auto offset = sf::Vector2f{ 2.0, 2.0 };
+		std::string count = std::to_string(item.count);
+
+		sf::Text itemCount;
+		itemCount.setFont(AssetManager::getFont("ConnectionSerif"));
+		itemCount.setString(count);
+		itemCount.setFillColor(sf::Color::White);
+		itemCount.setOutlineColor(sf::Color::Black);
+		itemCount.setOutlineThickness(1.2);
+		itemCount.setCharacterSize(counterSize);
+
+		auto endPos = itemCount.findCharacterPos(count.size());
+		itemCount.setPosition(pos + cell_size - sf::Vector2f{ endPos.x, (float)counterSize } - offset);
+		AssetManager::trackGlyphs(itemCount);
+		grid_counts.push_back(itemCount);
+	}
 }
 
 void InvUI::DrawSeparator(sf::RenderTarget& target) {
@@ -93,18 +192,6 @@ void InvUI::DrawSeparator(sf::RenderTarget& target) {
 	target.draw(separator);
 }
 
-void InvUI::DrawEquipment(sf::RenderTarget& target) {
-	sf::Vector2f cell_size(32, 32);
-	double offset_x = position.x + (size.x / 2.0) + ((size.x / 2.0) - 256.0) / 2.0;
-	double offset_y = position.y + 44;
-	sf::Vector2f equipment_offset(offset_x, offset_y);
-	
-	for (unsigned int index = 0; index < (unsigned int)EquipmentSlot::_DummyEnd; index++) {
-		DrawEqCell(target, equipment.getEquipmentBySlot((EquipmentSlot)index), index, equipment_offset, cell_size);
-		equipment_offset += sf::Vector2f(32, 0);
-	}
-}
-
 void InvUI::Update(int change) {
 	if (sec_focus == INVENTORY) {
 		if (focus < 8 and change == -8) {
@@ -151,10 +238,7 @@ void InvUI::ProcessKey(sf::Event::KeyEvent key) {
 					if (sec_focus == INVENTORY) {
 						//...FROM EQUIPMENT
 						if (action_source == EQUIPMENT) {
-							std::shared_ptr<Item> temp = equipment.getEquipmentBySlot((EquipmentSlot)action_index);
-							if (equipment.setEquipment((EquipmentSlot)action_index, inventory.getItem(focus))) {
-								inventory.getBackpack()[focus] = temp;
-							}
+							inventory.swapWithEquipment(focus, (EquipmentSlot)action_index);
 						}
 						//...FROM INVENTORY
 						else inventory.swapItems(focus, action_index);
@@ -163,10 +247,7 @@ void InvUI::ProcessKey(sf::Event::KeyEvent key) {
 					else if (sec_focus == EQUIPMENT) {
 						//...FROM INVENTORY
 						if (action_source == INVENTORY) {
-							std::shared_ptr<Item> temp = equipment.getEquipmentBySlot((EquipmentSlot)focus);
-							if (equipment.setEquipment((EquipmentSlot)focus, inventory.getItem(action_index))) {
-								inventory.getBackpack()[action_index] = temp;
-							}
+							inventory.swapWithEquipment(action_index, (EquipmentSlot)focus);
 						}
 						//...FROM EQUIPMENT
 						else {
@@ -179,8 +260,8 @@ void InvUI::ProcessKey(sf::Event::KeyEvent key) {
 				//MOV FLAG IS NOT SET
 				else {
 					if (sec_focus == INVENTORY) {
-						if (inventory.getItem(focus) != nullptr) {
-							subWin = std::make_shared<ItemUI>(*inventory.getItem(focus));
+						if (!inventory.getItem(focus).empty()) {
+							subWin = std::make_shared<ItemUI>(inventory.getItem(focus).toItem());
 							subWin->Init(focusCellPos, sf::Vector2f(0, 0));
 							subWin->ProcessKey(key);
 							action_index = focus;
@@ -188,8 +269,8 @@ void InvUI::ProcessKey(sf::Event::KeyEvent key) {
 						}
 					}
 					else if (sec_focus == EQUIPMENT) {
-						if (equipment.getEquipmentBySlot((EquipmentSlot)focus) != nullptr) {
-							subWin = std::make_shared<ItemUI>(*equipment.getEquipmentBySlot((EquipmentSlot)focus));
+						if (!equipment.getEquipmentBySlot((EquipmentSlot)focus).empty()) {
+							subWin = std::make_shared<ItemUI>(equipment.getEquipmentBySlot((EquipmentSlot)focus).toItem());
 							subWin->Init(focusCellPos, sf::Vector2f(0, 0));
 							subWin->ProcessKey(key);
 							action_index = focus;
@@ -205,10 +286,10 @@ void InvUI::ProcessKey(sf::Event::KeyEvent key) {
 		//REMEMBER ITEM TO MOVE
 		if (subWin->MovFlag()) {
 			if (action_source == INVENTORY) {
-				to_move = inventory.getItem(focus);
+				to_move = inventory.getHandle(InventorySection::Backpack, focus);
 			}
 			else if (action_source == EQUIPMENT) {
-				to_move = equipment.getEquipmentBySlot((EquipmentSlot)focus);
+				to_move = inventory.getHandle(InventorySection::Equipment, focus);
 			}
 		}
 	}
@@ -218,7 +299,7 @@ void InvUI::ProcessKey(sf::Event::KeyEvent key) {
 			inventory.deleteItem(action_index);
 		}
 		else if (action_source == EQUIPMENT) {
-			equipment.setEquipment((EquipmentSlot)action_index, nullptr);
+			inventory.removeEquipment((EquipmentSlot)action_index);
 		}
 		subWin->SetDelFlag(false);
 	}
@@ -241,18 +322,6 @@ void InvUI::DrawIcon(sf::RenderTarget& target, sf::Sprite& object, int index, sf
 	target.draw(object);
 }
 
-void InvUI::DrawEqCell(sf::RenderTarget& target, std::shared_ptr<Item> item, int index, sf::Vector2f position, sf::Vector2f size) {
-	Cell object{ item };
-	object.Init(position, size);
-	if (sec_focus == EQUIPMENT and focus == index) {
-		object.SetFocus();
-		focusCellPos = object.GetPosition();
-	}
-	else { object.RemoveFocus(); }
-	object.Draw(target);
-	if (!object.getItem()) DrawIcon(target, eq_legend, index, object.GetPosition(), object.GetSize());
-}
-
 void InvUI::DrawActorFace(sf::RenderTarget& target, sf::Vector2f position, sf::Vector2f size) {
 	Button frame("");
 	frame.Init(position, size);
@@ -270,31 +339,31 @@ void InvUI::DrawPlayerInfo(sf::RenderTarget& target, sf::Vector2f offset, int fo
 
 	//Level
 	offset += sf::Vector2f(0, font_size + 1);
-	DrawLine(target, offset, ParseText(player_info["lvl"], font_size - 2, "level "), sf::Color::Green);
+	DrawLine(target, offset, ParseText(player.getInfo("lvl"), font_size - 2, "level "), sf::Color::Green);
 
 	//HP
 	offset += sf::Vector2f(0, font_size );
 	DrawIcon(target, stat_icons, 0, offset, sf::Vector2f(32, 32));
-	DrawLine(target, offset + sf::Vector2f(32, 4), ParseText(statistics["HP"], statistics["MaxHP"], font_size - 2, "", "/"), sf::Color::Red);
-	DrawBar(target, offset + sf::Vector2f(32, 24), statistics["HP"], statistics["MaxHP"], sf::Vector2f(size.x / 2 - 168, 4), sf::Color::Red);
+	DrawLine(target, offset + sf::Vector2f(32, 4), ParseText(player.getStat("HP"), player.getStat("MaxHP"), font_size - 2, "", "/"), sf::Color::Red);
+	DrawBar(target, offset + sf::Vector2f(32, 24), player.getStat("HP"), player.getStat("MaxHP"), sf::Vector2f(size.x / 2 - 168, 4), sf::Color::Red);
 
 	//MP
 	offset += sf::Vector2f(0, 32);
 	DrawIcon(target, stat_icons, 1, offset, sf::Vector2f(32, 32));
-	DrawLine(target, offset + sf::Vector2f(32, 4), ParseText(statistics["MP"], statistics["MaxMP"], font_size - 2, "", "/"), sf::Color::Blue);
-	DrawBar(target, offset + sf::Vector2f(32, 24), statistics["MP"], statistics["MaxMP"], sf::Vector2f(size.x / 2 - 168, 4), sf::Color::Blue);
+	DrawLine(target, offset + sf::Vector2f(32, 4), ParseText(player.getStat("MP"), player.getStat("MaxMP"), font_size - 2, "", "/"), sf::Color::Blue);
+	DrawBar(target, offset + sf::Vector2f(32, 24), player.getStat("MP"), player.getStat("MaxMP"), sf::Vector2f(size.x / 2 - 168, 4), sf::Color::Blue);
 
 	//EXP
 	offset += sf::Vector2f(-104, 40);
-	DrawBar(target, offset, player_info["current"], player_info["next"], sf::Vector2f(size.x / 2 - 32, 4), sf::Color::Yellow);
-	DrawLine(target, offset + sf::Vector2f(0, 3), ParseText(player_info["current"], player_info["next"], font_size - 4, "EXP: ", "/"), sf::Color::White);
+	DrawBar(target, offset, player.getInfo("current"), player.getInfo("next"), sf::Vector2f(size.x / 2 - 32, 4), sf::Color::Yellow);
+	DrawLine(target, offset + sf::Vector2f(0, 3), ParseText(player.getInfo("current"), player.getInfo("next"), font_size - 4, "EXP: ", "/"), sf::Color::White);
 }
 
 void InvUI::DrawStatistics(sf::RenderTarget& target, sf::Vector2f position, int font_size) {
 
 //=============================== DATA ===============================//
 	//KEYS FOR STATISTIC MAP
-	std::vector<std::string> statIndex{ "HP","MaxHP",
+	static const std::vector<std::string> statIndex{ "HP","MaxHP",
 										"MP","MaxMP",
 										"Attack",
 										"Fire",
@@ -307,19 +376,6 @@ void InvUI::DrawStatistics(sf::RenderTarget& target, sf::Vector2f position, int
 										"Dodge"
 	};
 
-	//KEYS TO DISPLAY
-	std::vector<std::string> statNames{ "Life",				"",
-										"Mana",				"",
-										"Melee damage",
-										"Fire damage",
-										"Water damage",
-										"Lightning damage",
-										"Attack speed",
-										"Armor",
-										"Resistance",
-										"Critical",
-										"Dodge",
-	};
 //=========================== END OF DATA =============================//
 
 	for (int i = 4; i < statIndex.size(); i++) {
@@ -327,13 +383,13 @@ void InvUI::DrawStatistics(sf::RenderTarget& target, sf::Vector2f position, int
 		DrawIcon(target, stat_icons, i - 2, position + sf::Vector2f(2, 2), sf::Vector2f(32, 32));
 
 		//Get Base statistic
-		double middle = statistics[statIndex[i]];
+		double middle = player.getStat(statIndex[i]);
 
 		//Get all bonus statistic
 		for (unsigned j = 0; j < (unsigned)EquipmentSlot::_DummyEnd; ++j) {
-			auto item = player.getInventory().getEquipment().getEquipmentBySlot((EquipmentSlot)j);
-			if (item == nullptr) continue;
-			middle += item->getStat(statIndex[i]);
+			const auto& item = equipment.getEquipmentBySlot((EquipmentSlot)j);
+			if (item.empty()) continue;
+			middle += item.getStat((ItemStat)i);
 		}
 
 		std::string sufix = "";						//Default suffix
@@ -343,34 +399,34 @@ void InvUI::DrawStatistics(sf::RenderTarget& target, sf::Vector2f position, int
 		//Drawing and calculating depends of mechanic basis and kind of statistic
 		switch (i) {
 		case 4:		//Physical - Damage from 85% to 115% of middle value
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(floor, ceil, font_size, statNames[i] + ": ", "-"));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(floor, ceil, font_size, s_stat_names[i] + ": ", "-"));
 			break;
 		case 5:		//Fire - Damage from 85% to 115% of middle value
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(floor, ceil, font_size, statNames[i] + ": ", "-"));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(floor, ceil, font_size, s_stat_names[i] + ": ", "-"));
 			break;
 		case 6:		//Water	- Damage smaller but static, + reducting AS
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, statNames[i] + ": "));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, s_stat_names[i] + ": "));
 			break;
 		case 7:		//Lighning - Huge damage, but from 0 to middle value
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(0, middle, font_size, statNames[i] + ": ", "-"));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(0, middle, font_size, s_stat_names[i] + ": ", "-"));
 			break;
 		case 8:		//Attack speed - static value
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, statNames[i] + ": ", sufix));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, s_stat_names[i] + ": ", sufix));
 			break;
 		case 9:		//Armor - static value
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, statNames[i] + ": ", sufix));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, s_stat_names[i] + ": ", sufix));
 			break;
 		case 10:	//Resistance - static value in %
 			sufix = "%";
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, statNames[i] + ": ", sufix));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, s_stat_names[i] + ": ", sufix));
 			break;
 		case 11:	//Critical - static value in %
 			sufix = "%";
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, statNames[i] + ": ", sufix));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, s_stat_names[i] + ": ", sufix));
 			break;
 		case 12:	//Dodge - static value in %
 			sufix = "%";
-			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, statNames[i] + ": ", sufix));
+			DrawLine(target, position + sf::Vector2f(32, 8), ParseText(middle, font_size, s_stat_names[i] + ": ", sufix));
 			break;
 		}
 
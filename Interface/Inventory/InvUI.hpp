@@ -2,7 +2,6 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include "Interface/Components/Window.hpp"
-#include "Interface/Inventory/Cell.hpp"
 #include "Interface/Inventory/ItemUI.hpp"
 #include "Entity/Player.hpp"
 
@@ -32,10 +31,22 @@ protected:
 
 	//Holding Item
 	std::shared_ptr<ItemUI> subWin;	//to display info
-	std::shared_ptr<Item> to_move;	//to move
+	SlotHandle to_move;				//to move
 
 	sf::Vector2f focusCellPos;	//Position of focused cell
 
+	//Retained grid (inventory + equipment cells)
+	sf::VertexArray grid_cells;			//frames and backgrounds (windowskin)
+	sf::VertexArray grid_items;			//item icons (ItemList)
+	sf::VertexArray grid_legend;		//icons of empty equipment slots (eq_back)
+	std::vector<sf::Text> grid_counts;	//stack counters
+	bool grid_valid;
+	unsigned grid_revision;
+	int grid_focus;
+	section grid_section;
+	sf::Vector2f grid_position;
+	TextureHandle grid_skin, grid_sheet, grid_eq_back;
+
 	//Icons
 	sf::Sprite eq_legend;
 	sf::Sprite stat_icons;
@@ -43,8 +54,6 @@ protected:
 
 	//PLAYER
 	Player& player;								//Player
-	std::map<std::string, int>& statistics;		//Player's statistics
-	std::map<std::string, int>& player_info;	//Player's data info
 	PlayerInventory& inventory;					//Player's inventory
 	PlayerEquipment& equipment;					//Player's equipment
 
@@ -54,11 +63,13 @@ protected:
 public:
 	InvUI(Player&);
 	//Drawing Functions
-	void DrawInventory(sf::RenderTarget&);	//draw eq cells
-	void DrawEquipment(sf::RenderTarget&);
+	void DrawGrid(sf::RenderTarget&);		//draw inventory and equipment cells
 	void DrawSeparator(sf::RenderTarget&);
 	void DrawIcon(sf::RenderTarget&, sf::Sprite&, int, sf::Vector2f, sf::Vector2f);
-	void DrawEqCell(sf::RenderTarget&, std::shared_ptr<Item>, int, sf::Vector2f, sf::Vector2f);
+	//Retained grid
+	bool GridOutdated() const;
+	void RebuildGrid();
+	void AppendCell(const ItemSlot&, sf::Vector2f, sf::Vector2f, bool);
 	void DrawActorFace(sf::RenderTarget&, sf::Vector2f, sf::Vector2f);
 	void DrawPlayerInfo(sf::RenderTarget&, sf::Vector2f, int);
 	void DrawStatistics(sf::RenderTarget&, sf::Vector2f, int);
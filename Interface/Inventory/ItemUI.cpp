@@ -64,6 +64,9 @@ void ItemUI::SelfInit() {
 	value = sf::Text(std::to_string(item.getValue()), font, 15);
 	value.setFillColor(sf::Color::Black);
 
+	for (auto* text : { &quality, &name, &stats, &description, &type, &value })
+		AssetManager::trackGlyphs(*text);
+
 	//SIZE AND POSITION
 	double window_width = 200;
 	
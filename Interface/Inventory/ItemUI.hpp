@@ -30,7 +30,7 @@ protected:
 	bool use;
 
 	//Source of Content
-	const Item& item;
+	Item item;
 
 	//Managing Buttons
 	std::vector<Button> buttons;
@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include "MemoryOverlay.hpp"
+
+static const float s_refresh_interval = 0.5f;
+static const unsigned s_character_size = 14;
+static const float s_line_height = 18.f;
+
+static std::string FormatBytes(std::size_t bytes) {
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%7.2f MiB", bytes / (1024.0 * 1024.0));
+	return buffer;
+}
+
+void MemoryOverlay::Toggle() {
+	visible = !visible;
+	if(visible) Refresh();
+}
+
+void MemoryOverlay::Refresh() {
+	refreshClock.restart();
+	const auto report = AssetManager::measureMemory();
+
+	lines[0] = sf::Text("Category        Count       GPU            CPU", font, s_character_size);
+	for(unsigned i = 0; i < (unsigned)MemoryCategory::_DummyEnd; ++i) {
+		const auto category = (MemoryCategory)i;
+		const auto& usage = report[category];
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "%-15s %5u ", MemoryBudget::categoryName(category), usage.count);
+		std::string line = name + FormatBytes(usage.gpu) + "  " + FormatBytes(usage.cpu);
+		if(MemoryBudget::getBudget(category))
+			line += "  / " + FormatBytes(MemoryBudget::getBudget(category));
+
+		lines[i + 1] = sf::Text(line, font, s_character_size);
+		lines[i + 1].setFillColor(MemoryBudget::exceeded(category, usage) ? sf::Color::Red : sf::Color::White);
+	}
+
+	auto& total = lines[(unsigned)MemoryCategory::_DummyEnd + 1];
+	total = sf::Text("Total                 " + FormatBytes(report.gpuTotal()) + "  " + FormatBytes(report.cpuTotal()),
+	                 font, s_character_size);
+	total.setFillColor(sf::Color::Yellow);
+
+	float width = 0.f;
+	for(auto& line : lines)
+		width = std::max(width, line.getLocalBounds().width);
+
+	background.setSize(sf::Vector2f(width + 16.f, s_line_height * (float)std::size(lines) + 12.f));
+	background.setFillColor(sf::Color(0, 0, 0, 180));
+}
+
+void MemoryOverlay::Draw(sf::RenderTarget& target) {
+	if(!visible) return;
+	if(refreshClock.getElapsedTime().asSeconds() > s_refresh_interval)
+		Refresh();
+
+	background.setPosition(8.f, 8.f);
+	target.draw(background);
+	for(unsigned i = 0; i < std::size(lines); ++i) {
+		lines[i].setPosition(16.f, 14.f + s_line_height * i);
+		target.draw(lines[i]);
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "AssetManager.hpp"
+#include "MemoryBudget.hpp"
+
+/*
+ *      MemoryOverlay - podgląd zużycia pamięci przez zasoby (F3)
+ *  Pomiar przechodzi po wszystkich zasobach, więc odświeżany jest co pół sekundy,
+ *  a nie co klatkę. Kategorie z przekroczonym limitem wyświetlane są na czerwono.
+ */
+class MemoryOverlay {
+private:
+	const sf::Font& font;
+	sf::RectangleShape background;
+	sf::Text lines[(unsigned)MemoryCategory::_DummyEnd + 2];
+	sf::Clock refreshClock;
+	bool visible;
+
+	void Refresh();
+public:
+	MemoryOverlay() : font(AssetManager::getFont("VCR_OSD_MONO")), visible(false) {};
+
+	void Toggle();
+	bool IsVisible() const { return visible; }
+	void Draw(sf::RenderTarget&);
+};
@@ -6,18 +6,20 @@
 class OptionWindow : public RawWindow {
 protected:
 	sf::Text message;
+	NineSlice tail;		//zakończenie dymka po prawej stronie
 	int fontsize;
 public:
 	void DrawSelf(sf::RenderTarget& target) override {
-		final.setScale(1.0, (size.y) / 64);
-		final.setTextureRect(sf::IntRect(212, 0, 44, 64));
-		final.setPosition(position + sf::Vector2f(size.x,0));
-		target.draw(final);
+		tail.setPosition(position + sf::Vector2f(size.x,0));
+		tail.setSize(sf::Vector2f(44, size.y));
+		target.draw(tail);
 		message.setCharacterSize(fontsize);
 		message.setPosition(position + sf::Vector2f(4, (size.y - fontsize)/4));
 		target.draw(message);
 	}
 	void SelfInit(int fsiz)override {
+		tail = panel;
+		tail.setStyle(NineSlice::rawStyle(sf::IntRect(212, 0, 44, 64)));
 		message = sf::Text(" ", font, 24);
 		fontsize = fsiz;
 		SetFontColor(sf::Color::Black);
@@ -26,8 +28,10 @@ public:
 
 	void SetMessage(sf::String mess) { 
 		message.setString(mess); 
+		message.setCharacterSize(fontsize);
+		AssetManager::trackGlyphs(message);
 	}
-	void SetColor(sf::Color color) { final.setColor(color); }
+	void SetColor(sf::Color color) { panel.setColor(color); tail.setColor(color); }
 	void SetFontColor(sf::Color color) { message.setFillColor(color); }
 	void SetFontSize(int size) { message.setCharacterSize(size); }
 	void SetFocus() { SetColor(sf::Color(183, 149, 77)); }
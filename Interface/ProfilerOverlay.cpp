@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstdio>
+#include "ProfilerOverlay.hpp"
+
+static const float s_refresh_interval = 0.5f;
+static const unsigned s_character_size = 14;
+static const float s_line_height = 18.f;
+static const float s_bar_width = 2.f;
+static const float s_graph_height = 100.f;
+static const float s_graph_range_ms = 1000.f / 30.f;	//  pełna wysokość wykresu - 30 FPS
+static const float s_frame_budget_ms = 1000.f / 60.f;
+static const unsigned s_stats_frames = 60;
+static const sf::Vector2f s_padding(8.f, 8.f);
+
+void ProfilerOverlay::Toggle() {
+	visible = !visible;
+	Profiler::setEnabled(visible);
+	if(visible) Refresh();
+}
+
+void ProfilerOverlay::Refresh() {
+	refreshClock.restart();
+
+	const auto times = Profiler::frameTimes();
+	float average = 0.f, worst = 0.f;
+	for(auto time : times) {
+		average += time;
+		worst = std::max(worst, time);
+	}
+	if(!times.empty()) average /= times.size();
+
+	char line[128];
+	std::snprintf(line, sizeof(line), "Frame avg %5.2f max %5.2f ms  glyph miss %u  (F5: trace)",
+	              average, worst, AssetManager::getGlyphMisses());
+	header = sf::Text(line, font, s_character_size);
+
+	const auto top = Profiler::topScopes(s_stats_frames, topCount);
+	const unsigned frames = std::max<std::size_t>(1, std::min<std::size_t>(s_stats_frames, times.size() + 1));
+	scopeCount = top.size();
+	for(unsigned i = 0; i < scopeCount; ++i) {
+		std::snprintf(line, sizeof(line), "%-24.24s %6.2f ms  max %6.2f  x%u",
+		              top[i].name.c_str(), top[i].totalMs / frames, top[i].maxMs, top[i].calls / frames);
+		scopes[i] = sf::Text(line, font, s_character_size);
+	}
+}
+
+void ProfilerOverlay::UpdateGraph() {
+	const auto times = Profiler::frameTimes();
+	graph.resize(times.size() * 4);
+
+	for(unsigned i = 0; i < times.size(); ++i) {
+		const float height = std::min(times[i] / s_graph_range_ms, 1.f) * s_graph_height;
+		const float x = i * s_bar_width;
+		const sf::Color color = times[i] > s_frame_budget_ms ? sf::Color(230, 60, 60) : sf::Color(80, 200, 80);
+
+		sf::Vertex* quad = &graph[i * 4];
+		quad[0] = sf::Vertex(sf::Vector2f(x, s_graph_height - height), color);
+		quad[1] = sf::Vertex(sf::Vector2f(x + s_bar_width, s_graph_height - height), color);
+		quad[2] = sf::Vertex(sf::Vector2f(x + s_bar_width, s_graph_height), color);
+		quad[3] = sf::Vertex(sf::Vector2f(x, s_graph_height), color);
+	}
+}
+
+void ProfilerOverlay::Draw(sf::RenderTarget& target) {
+	if(!visible) return;
+	if(refreshClock.getElapsedTime().asSeconds() > s_refresh_interval)
+		Refresh();
+	UpdateGraph();
+
+	const float graphWidth = Profiler::frameCapacity * s_bar_width;
+	const sf::Vector2f size(graphWidth + s_padding.x * 2, s_graph_height + s_line_height * (scopeCount + 1) + s_padding.y * 3);
+	const sf::Vector2f position(target.getView().getSize().x - size.x - 8.f, 8.f);
+
+	background.setSize(size);
+	background.setPosition(position);
+	background.setFillColor(sf::Color(0, 0, 0, 180));
+	target.draw(background);
+
+	sf::Transform transform;
+	transform.translate(position + s_padding);
+	target.draw(graph, transform);
+
+	budgetLine.setSize(sf::Vector2f(graphWidth, 1.f));
+	budgetLine.setPosition(position + s_padding + sf::Vector2f(0.f, s_graph_height * (1.f - s_frame_budget_ms / s_graph_range_ms)));
+	budgetLine.setFillColor(sf::Color::Yellow);
+	target.draw(budgetLine);
+
+	sf::Vector2f textPosition = position + s_padding + sf::Vector2f(0.f, s_graph_height + s_padding.y);
+	header.setPosition(textPosition);
+	target.draw(header);
+	for(unsigned i = 0; i < scopeCount; ++i) {
+		textPosition.y += s_line_height;
+		scopes[i].setPosition(textPosition);
+		target.draw(scopes[i]);
+	}
+}
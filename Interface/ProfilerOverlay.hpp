@@ -0,0 +1,33 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "AssetManager.hpp"
+#include "Profiler.hpp"
+
+/*
+ *      ProfilerOverlay - wykres czasów klatek i najdroższe fazy (F4)
+ *  Włączenie nakładki włącza również profiler. Wykres odświeżany jest co klatkę,
+ *  a zestawienie faz (z ostatniej sekundy) co pół sekundy.
+ */
+class ProfilerOverlay {
+private:
+	static const unsigned topCount = 10;
+
+	const sf::Font& font;
+	sf::RectangleShape background;
+	sf::VertexArray graph;
+	sf::RectangleShape budgetLine;
+	sf::Text header;
+	sf::Text scopes[topCount];
+	unsigned scopeCount;
+	sf::Clock refreshClock;
+	bool visible;
+
+	void Refresh();
+	void UpdateGraph();
+public:
+	ProfilerOverlay() : font(AssetManager::getFont("VCR_OSD_MONO")), graph(sf::Quads), scopeCount(0), visible(false) {};
+
+	void Toggle();
+	bool IsVisible() const { return visible; }
+	void Draw(sf::RenderTarget&);
+};
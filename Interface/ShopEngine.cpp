@@ -1,15 +1,24 @@
+#include <algorithm>
 #include "Interface/ShopEngine.hpp"
 #include "Interface/Components/Window.hpp"
 #include "Interface/Components/UnsignedSwitch.hpp"
 #include "Interface/OptionWindow.hpp"
 #include "Sound/SoundEngine.hpp"
+#include "World/WorldManager.hpp"
 #include "Entity/Script.hpp"
+#include "Profiler.hpp"
 
 enum class SelectedButton {
 	Buy,
 	AmountPicker
 };
 
+static const Vec2f s_window_size {500, 400};
+static const Vec2f s_seller_size {100.0, 60.0};
+static const Vec2f s_item_window_offset {20.0, 20.0};
+static const Vec2f s_item_window_size {s_window_size.x - 40.0f, 80.0f};
+static const float s_item_window_padding {10.0f};
+
 ShopEngine* ShopEngine::instance {nullptr};
 static unsigned selectedItem {0};
 static unsigned selectionOffset {0};
@@ -17,7 +26,7 @@ static bool shopOpen {false};
 static std::vector<UnsignedSwitch> switchStates;
 
 ShopEngine::ShopEngine(Player &_player)
-: player(_player), itemlist_cache(AssetManager::getJSON("ItemList")), font(AssetManager::getFont("VCR_OSD_MONO"))
+: player(_player), font(AssetManager::getFont("VCR_OSD_MONO"))
 { instance = this; }
 
 void ShopEngine::initializeShop(Shop shop, Script* ptr) {
@@ -26,6 +35,20 @@ void ShopEngine::initializeShop(Shop shop, Script* ptr) {
 		std::cout << a.designator << ": " << a.count << " x " << a.price << "\n";
 	}
 
+	//  Rozwiązanie nazw przedmiotów raz, przy otwarciu sklepu
+	auto it = shop.shopItems.begin();
+	while(it != shop.shopItems.end()) {
+		it->id = ItemRegistry::findID(it->designator);
+		if(it->id == ItemRegistry::invalidID) {
+			std::cerr << "ShopEngine: item '" << it->designator << "' does not exist, skipping\n";
+			it = shop.shopItems.erase(it);
+			continue;
+		}
+		++it;
+	}
+	if(shop.shopItems.empty())
+		std::cerr << "ShopEngine: shop of '" << shop.traderName << "' has nothing to sell, closing it\n";
+
 	caller = ptr;
 	currentShop = shop;
 	shopOpen = true;
@@ -33,125 +56,167 @@ void ShopEngine::initializeShop(Shop shop, Script* ptr) {
 	selectionOffset = 0;
 	switchStates.clear();
 	switchStates.resize(shop.shopItems.size());
-}
 
-void ShopEngine::draw(sf::RenderTarget& target) {
-	if(!shopOpen) return;
+	sellerWindow.Init({0.0, 0.0}, s_seller_size, "quote_window", 20);
+	sellerWindow.SetMessage(currentShop.traderName);
 
-	auto draw_item_at = [&](Vec2f pos, const std::string& id) {
-		const auto index = itemlist_cache[id]["itemSprite"].get<unsigned>();
-		auto sprite = AssetManager::getUI("ItemList").getSprite(index);
-		sprite.setPosition(pos);
-		target.draw(sprite);
-	};
+	build_item_views();
+	viewGold = -1;
+	refresh_affordability();
+	layoutValid = false;
+}
+
+/*
+ *  Składa teksty wszystkich wpisów sklepu. Pozycje zapisywane są względem lewego górnego
+ *  rogu okienka przedmiotu, więc przewijanie listy nie wymaga ponownego układania tekstu.
+ */
+void ShopEngine::build_item_views() {
+	const Vec2f textStart {50.0, 10.0};
 
-	auto draw_text_at = [&](Vec2f pos, const std::string& text, sf::Color color) -> Vec2f {
-		sf::Text txt;
+	auto make_text = [&](sf::Text& txt, const std::string& text, sf::Color color) -> Vec2f {
 		txt.setCharacterSize(14);
 		txt.setFont(font);
 		txt.setString(text);
 		txt.setFillColor(color);
 		txt.setOutlineColor(color);
+		AssetManager::trackGlyphs(txt);
 
-		auto ret = txt.findCharacterPos(text.size()+1);;
+		auto ret = txt.findCharacterPos(text.size()+1);
 		ret.y = 14;
-		txt.setPosition(pos);
-
-		target.draw(txt);
 		return ret;
 	};
 
-	auto item_name = [&](const std::string& id) -> std::string {
-		return itemlist_cache[id]["name"].get<std::string>();
-	};
+	itemViews.clear();
+	itemViews.reserve(currentShop.shopItems.size());
+	for(const auto& item : currentShop.shopItems) {
+		ShopItemView view;
+		const auto& def = ItemRegistry::getDefinition(item.id);
+		view.id = item.id;
+		view.color = Item::getRarityColor(def.rarity);
 
-	auto item_description = [&](const std::string& id) -> std::string {
-		return itemlist_cache[id]["description"].get<std::string>();
-	};
+		Vec2f text_offset {0.0, 0.0};
+		view.nameOffset = textStart;
+		text_offset = make_text(view.name, def.name, view.color);
 
-	auto item_rarity = [&](const std::string& id) -> unsigned {
-		return itemlist_cache[id]["rarity"].get<unsigned>();
-	};
+		view.countOffset = textStart + Vec2f{text_offset.x + 10.0f, 0.0};
+		make_text(view.count, "x" + std::to_string(item.count), sf::Color(0xffffffff));
 
-	auto item_gold = [&](const std::string& id) -> unsigned {
-		return itemlist_cache[id]["value"].get<unsigned>();
-	};
+		view.descriptionOffset = textStart + Vec2f{0.0, text_offset.y};
+		text_offset += make_text(view.description, def.description, sf::Color::Black);
+
+		view.typeOffset = textStart + Vec2f{0.0, text_offset.y};
+		make_text(view.type, Item::getTypeString(def.type), sf::Color::Black);
+
+		make_text(view.price, std::to_string(item.price), sf::Color::Yellow);
+		itemViews.push_back(std::move(view));
+	}
+}
+
+/*
+ *  Limity ilości i kolory cen zależą jedynie od złota gracza i miejsca w plecaku - przeliczane
+ *  tylko gdy któreś się zmieni
+ */
+void ShopEngine::refresh_affordability() {
+	const int gold = player.getInfo("gold");
+	const unsigned inventoryRevision = player.getInventory().getRevision();
+	if(gold == viewGold && inventoryRevision == viewInventoryRevision) return;
+	viewGold = gold;
+	viewInventoryRevision = inventoryRevision;
+
+	for(unsigned i = 0; i < itemViews.size(); ++i) {
+		auto& view = itemViews[i];
+		const auto& item = currentShop.shopItems[i];
+
+		view.limit = calculate_limit_for_item(item);
+		view.affordable = view.limit > 0;
+		view.price.setFillColor(view.affordable ? sf::Color::Yellow : sf::Color(160, 40, 40));
+		view.price.setOutlineColor(view.price.getFillColor());
+		switchStates[i].setLimit(view.limit);
+	}
+}
+
+/*
+ *  Rozmieszcza okno sklepu, okienka widocznych przedmiotów i ich przełączniki ilości
+ */
+void ShopEngine::build_layout(Vec2f viewSize) {
+	layoutViewSize = viewSize;
+	layoutOffset = selectionOffset;
+	windowPos = (viewSize - s_window_size) / 2.0f;
+
+	window.Init(windowPos, s_window_size);
+	sellerWindow.SetPosition((windowPos + Vec2f{s_window_size.x, 0.0f}) - s_seller_size/2.0f - Vec2f{40.0, 0.0});
+
+	visibleItems = 0;
+	for(unsigned i = selectionOffset; i < currentShop.shopItems.size(); ++i) {
+		const Vec2f itemWindowPos {windowPos + s_item_window_offset + Vec2f{0.0f, visibleItems * (s_item_window_size.y + s_item_window_padding)}};
+		if(itemWindowPos.y + s_item_window_size.y > windowPos.y + s_window_size.y)
+			break;
+
+		if(itemWindows.size() <= visibleItems)
+			itemWindows.resize(visibleItems + 1);
+		auto& itemWindow = itemWindows[visibleItems++];
+		itemWindow.Init(itemWindowPos, s_item_window_size);
+		itemWindow.setTint(itemViews[i].color);
+
+		switchStates[i].Init(itemWindowPos + s_item_window_size - Vec2f {80.0, 30.0}, {60.0, 25.0});
+	}
+	layoutValid = true;
+}
+
+void ShopEngine::draw(sf::RenderTarget& target) {
+	PROFILE_SCOPE("Shop draw");
+	if(!shopOpen) return;
+
+	refresh_affordability();
 
-	auto item_type = [&](const std::string& id) -> std::string {
-		return Item::getTypeString((ItemType)itemlist_cache[id]["type"].get<unsigned>());
+	const Vec2f viewSize = target.getView().getSize();
+	if(!layoutValid || layoutViewSize != viewSize || layoutOffset != selectionOffset)
+		build_layout(viewSize);
+
+	static const TextureHandle itemSheet = AssetManager::findUI("ItemList");
+	auto draw_item_at = [&](Vec2f pos, const ItemDef& def) {
+		auto sprite = AssetManager::getSpritesheet(itemSheet).getSprite(def.itemSprite);
+		sprite.setPosition(pos);
+		target.draw(sprite);
 	};
 
+	auto draw_text_at = [&](sf::Text& text, Vec2f pos) {
+		text.setPosition(pos);
+		target.draw(text);
+	};
 
-	auto view = target.getView();
-	const Vec2f windowSize {500, 400};
-	const Vec2f windowPos = (view.getSize() - windowSize) / 2.0f;
 	const Vec2f itemSize {32.0f, 32.0f};
-	const Vec2f itemWindowPadding {0.0, 10.0f};
-	const Vec2f itemWindowSize = Vec2f{windowSize.x - 40.0f, 80.0f};
-	const Vec2f textStart {50.0, 10.0};
 
-	Window window;
-	window.Init(windowPos, windowSize);
 	window.Draw(target);
-
-	OptionWindow sellerWindow;
-	const Vec2f sellerNameSize {100.0, 60.0};
-	sellerWindow.Init((windowPos + Vec2f{windowSize.x, 0.0f}) - sellerNameSize/2.0f - Vec2f{40.0, 0.0}, sellerNameSize, "quote_window", 20);
-	sellerWindow.SetMessage(currentShop.traderName);
 	sellerWindow.Draw(target);
 
+	for(unsigned k = 0; k < visibleItems; ++k) {
+		const unsigned i = layoutOffset + k;
+		auto& itemView = itemViews[i];
+		const auto& def = ItemRegistry::getDefinition(itemView.id);
 
-
-	Vec2f itemWindowOffset {20.0, 20.0};
-	for(unsigned i = selectionOffset; i < currentShop.shopItems.size(); ++i) {
-		const auto& item = currentShop.shopItems[i];
-
-		const Vec2f itemWindowPos {windowPos + itemWindowOffset};
+		const Vec2f itemWindowPos {windowPos + s_item_window_offset + Vec2f{0.0f, k * (s_item_window_size.y + s_item_window_padding)}};
 		const Vec2f itemPos {
 			itemWindowPos.x + 10.0f,
-			itemWindowPos.y + (itemWindowSize.y - itemSize.y) / 2.0f
+			itemWindowPos.y + (s_item_window_size.y - itemSize.y) / 2.0f
 		};
-		const Vec2f itemWindowRB {itemWindowPos+itemWindowSize};
-
-		if(itemWindowRB.y > windowPos.y + windowSize.y)
-			break;
-
-		itemWindowOffset.y += itemWindowSize.y + itemWindowPadding.y;
 
-		auto color = Item::getRarityColor((Rarity)item_rarity(item.designator));
-		Window itemWindow;
-		itemWindow.Init(itemWindowPos, itemWindowSize);
-		itemWindow.setTint(color);
-		itemWindow.Draw(target);
+		itemWindows[k].Draw(target);
+		draw_item_at(itemPos, def);
 
-		draw_item_at(itemPos, item.designator);
+		draw_text_at(itemView.name, itemWindowPos + itemView.nameOffset);
+		draw_text_at(itemView.count, itemWindowPos + itemView.countOffset);
+		draw_text_at(itemView.description, itemWindowPos + itemView.descriptionOffset);
+		draw_text_at(itemView.type, itemWindowPos + itemView.typeOffset);
 
-		Vec2f text_offset {0.0, 0.0};
-		text_offset  = draw_text_at(itemWindowPos + textStart,
-					               item_name(item.designator),
-					               color);
-						draw_text_at(itemWindowPos + textStart + Vec2f{text_offset.x + 10.0f, 0.0},
-		                            "x" + std::to_string(item.count),
-		                            sf::Color(0xffffffff));
-
-		text_offset += draw_text_at(itemWindowPos + textStart + Vec2f{0.0, text_offset.y},
-									item_description(item.designator),
-									sf::Color::Black);
-		text_offset += draw_text_at(itemWindowPos + textStart + Vec2f{0.0, text_offset.y},
-		                            item_type(item.designator),
-		                            sf::Color::Black);
-
-		const Vec2f coinPos {itemWindowPos + itemWindowSize - Vec2f{160.0, 25.0}};
-		sf::Sprite coinSprite = AssetManager::getUI("coin").getSprite();
+		const Vec2f coinPos {itemWindowPos + s_item_window_size - Vec2f{160.0, 25.0}};
+		static const TextureHandle coin = AssetManager::findUI("coin");
+		sf::Sprite coinSprite = AssetManager::getSpritesheet(coin).getSprite();
 		coinSprite.setPosition(coinPos);
 		target.draw(coinSprite);
-		draw_text_at(coinPos + Vec2f{25.0, 0.0}, std::to_string(item.price), sf::Color::Yellow);
+		draw_text_at(itemView.price, coinPos + Vec2f{25.0, 0.0});
 
-		const Vec2f picker_position {itemWindowPos + itemWindowSize - Vec2f {80.0, 30.0}};
 		auto& picker = switchStates[i];
-		picker.setLimit(calculate_limit_for_item(item));
-		picker.Init(picker_position, {60.0, 25.0});
-
 		if(selectedItem == i) picker.SetFocus();
 		else picker.RemoveFocus();
 
@@ -159,8 +224,22 @@ void ShopEngine::draw(sf::RenderTarget& target) {
 	}
 }
 
+/*
+ *  Pusty sklep zamykany jest w kolejnej klatce - initializeShop wołane jest jeszcze z wnętrza
+ *  korutyny skryptu, więc nie może jej od razu wznowić
+ */
+void ShopEngine::update() {
+	if(!shopOpen || !currentShop.shopItems.empty()) return;
+
+	handleShopClose();
+	if(!caller)
+		shopOpen = false;
+}
+
 void ShopEngine::handleKeyEvent(const sf::Event::KeyEvent& event) {
 	if(!shopOpen) return;
+	//  Bez przedmiotów jedyną możliwą akcją jest zamknięcie
+	if(currentShop.shopItems.empty() && event.code != sf::Keyboard::Escape) return;
 
 	switch(event.code) {
 		case sf::Keyboard::Escape:
@@ -177,7 +256,7 @@ void ShopEngine::handleKeyEvent(const sf::Event::KeyEvent& event) {
 
 			break;
 		case sf::Keyboard::S:
-			if(selectedItem < currentShop.shopItems.size() - 1)
+			if(selectedItem + 1 < currentShop.shopItems.size())
 				selectedItem++;
 			else
 				break;
@@ -190,9 +269,7 @@ void ShopEngine::handleKeyEvent(const sf::Event::KeyEvent& event) {
 			switchStates[selectedItem].Previous();
 			break;
 		case sf::Keyboard::D:
-			switchStates[selectedItem].setLimit(
-					calculate_limit_for_item(currentShop.shopItems[selectedItem])
-			);
+			refresh_affordability();
 			switchStates[selectedItem].Next();
 			break;
 		case sf::Keyboard::Space:
@@ -213,33 +290,33 @@ bool ShopEngine::handleItemBuy() {
 	const unsigned item_count = switchStates[selectedItem].value() * item.count;
 	const unsigned price = item_count * price_per_unit;
 
-	if(player.getPlayerInfo()["gold"] < price)
+	if(player.getInfo("gold") < price)
 		return false;
 
 	auto& inventory = player.getInventory();
-	auto invItem = std::make_shared<Item>(item.designator, item_count);
-	if(inventory.addItem(*invItem) == inventory.getBackpack().size())
+	if(!inventory.addItems(ItemBundle{{item.id, item_count}}))
 		return false;
 
-	if(invItem->getMaxStack() == 1) {
-		player.getPlayerInfo()["gold"] -= price_per_unit;
-		for(unsigned i = 0; i < item_count - 1; ++i) {
-			invItem = std::make_shared<Item>(item.designator, 1);
-			if(inventory.addItem(*invItem) == inventory.getBackpack().size())
-				return false;
-
-			player.getPlayerInfo()["gold"] -= price_per_unit;
-		}
-	} else
-		player.getPlayerInfo()["gold"] -= price;
-
+	player.modifyInfo("gold", -(int)price);
+	WorldManager::shouldAutosave();
 
-	SoundEngine::get().playSound("coins");
+	SoundEngine::get().playSound("coins", SoundPriority::Interface);
 	return true;
 }
 
+/*
+ *  Ile paczek przedmiotu gracz może kupić - ograniczone złotem oraz miejscem w plecaku.
+ *  Darmowe przedmioty (cena 0) ogranicza wyłącznie miejsce.
+ */
 unsigned ShopEngine::calculate_limit_for_item(const ShopItem& item) const {
-	unsigned val = player.getPlayerInfo()["gold"] / item.price;
+	if(item.count == 0) return 0;
+
+	unsigned val = player.getInventory().roomFor(item.id) / item.count;
+	if(item.price > 0) {
+		const int gold = player.getInfo("gold");
+		//  Cena jest za sztukę, a paczka zawiera item.count sztuk
+		val = std::min(val, gold > 0 ? (unsigned)gold / (item.price * item.count) : 0u);
+	}
 	return val;
 }
 
@@ -1,10 +1,13 @@
 #pragma once
 #include "Entity/Player.hpp"
+#include "Interface/Components/Window.hpp"
+#include "Interface/OptionWindow.hpp"
 
 struct ShopItem {
 	std::string designator;
 	unsigned count;
 	unsigned price;
+	ItemID id {ItemRegistry::invalidID};
 };
 
 struct SellItem {
@@ -18,23 +21,55 @@ struct Shop {
 	std::string traderName;
 };
 
+/*
+ *      ShopItemView - wpis sklepu przygotowany do rysowania
+ *  Budowany raz w initializeShop: teksty są już złożone i rozmieszczone względem okienka
+ *  przedmiotu. Co klatkę zmienia się jedynie pozycja. Definicja przedmiotu pobierana jest
+ *  przy rysowaniu - przeładowanie ItemRegistry może przenieść ją w pamięci.
+ */
+struct ShopItemView {
+	ItemID id {ItemRegistry::invalidID};
+	sf::Color color;
+	sf::Text name, count, description, type, price;
+	Vec2f nameOffset, countOffset, descriptionOffset, typeOffset;
+	unsigned limit {0};
+	bool affordable {false};
+};
+
 class ShopEngine {
 	friend class Script;
 
 	static ShopEngine* instance;
 
 	Script* caller {nullptr};
-	const nlohmann::json& itemlist_cache;
 	Player& player;
 	Shop currentShop;
+	std::vector<ShopItemView> itemViews;
+	int viewGold {-1};
+	unsigned viewInventoryRevision {0};
 	const sf::Font& font;
 
+	Window window;
+	OptionWindow sellerWindow;
+	std::vector<Window> itemWindows;
+
+	//  Układ okien - przebudowywany przy otwarciu sklepu, zmianie rozmiaru widoku i przewinięciu listy
+	Vec2f layoutViewSize;
+	Vec2f windowPos;
+	unsigned layoutOffset {0};
+	unsigned visibleItems {0};
+	bool layoutValid {false};
+
+	void build_item_views();
+	void build_layout(Vec2f viewSize);
+	void refresh_affordability();
 	unsigned calculate_limit_for_item(const ShopItem&) const;
 	bool handleItemBuy();
 	void handleShopClose();
 public:
 	ShopEngine(Player& _player);
 	void initializeShop(Shop, Script*);
+	void update();
 	void draw(sf::RenderTarget&);
 	void handleKeyEvent(const sf::Event::KeyEvent&);
 	bool isShopOpen();
@@ -1,5 +1,6 @@
 #include <SFML/Graphics.hpp>
 #include "Engine.hpp"
+#include "Save.hpp"
 
 int main() {
 	Engine engine;
@@ -9,6 +10,7 @@ int main() {
 		std::cerr << "ProjectRPG has encountered an error and needs to close\n";
 		std::cerr << "Details: " << ex.what() << "\n";
 	}
+	SaveWriter::flush();
 
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <iostream>
+#include "MemoryBudget.hpp"
+
+static const char* s_category_names[(unsigned)MemoryCategory::_DummyEnd] = {
+	"Textures",
+	"VertexBuffers",
+	"SoundBuffers",
+	"Json",
+	"Lua"
+};
+
+std::size_t MemoryReport::gpuTotal() const {
+	std::size_t total = 0;
+	for(const auto& usage : categories)
+		total += usage.gpu;
+	return total;
+}
+
+std::size_t MemoryReport::cpuTotal() const {
+	std::size_t total = 0;
+	for(const auto& usage : categories)
+		total += usage.cpu;
+	return total;
+}
+
+const char* MemoryBudget::categoryName(MemoryCategory category) {
+	if(category >= MemoryCategory::_DummyEnd) return "undefined";
+	return s_category_names[(unsigned)category];
+}
+
+MemoryCategory MemoryBudget::categoryFromName(const std::string& name) {
+	for(unsigned i = 0; i < (unsigned)MemoryCategory::_DummyEnd; ++i) {
+		if(name == s_category_names[i])
+			return (MemoryCategory)i;
+	}
+	return MemoryCategory::_DummyEnd;
+}
+
+/*
+ *  Wczytuje limity z konfiguracji - klucze to nazwy kategorii, wartości w MiB
+ */
+void MemoryBudget::configure(const nlohmann::json& config) {
+	if(!config.is_object()) {
+		std::cerr << "MemoryBudget::configure() expected an object of budgets\n";
+		return;
+	}
+
+	for(auto it = config.begin(); it != config.end(); ++it) {
+		auto category = categoryFromName(it.key());
+		if(category == MemoryCategory::_DummyEnd || !it.value().is_number()) {
+			std::cerr << "MemoryBudget::configure()/ Ignoring unknown budget '" << it.key() << "'\n";
+			continue;
+		}
+
+		const double megabytes = it.value().get<double>();
+		setBudget(category, megabytes > 0.0 ? (std::size_t)(megabytes * 1024.0 * 1024.0) : 0);
+		std::cout << "MemoryBudget/ " << it.key() << " limited to " << megabytes << " MiB\n";
+	}
+}
+
+std::size_t MemoryBudget::estimateJson(const nlohmann::json& document) {
+	using json = nlohmann::json;
+	std::size_t size = sizeof(json);
+
+	switch(document.type()) {
+		case json::value_t::object:
+			//  Węzeł std::map - klucz, wartość i wskaźniki drzewa
+			for(auto it = document.begin(); it != document.end(); ++it)
+				size += sizeof(std::string) + it.key().capacity() + 4 * sizeof(void*) + estimateJson(it.value());
+			break;
+		case json::value_t::array:
+			for(const auto& element : document)
+				size += estimateJson(element);
+			break;
+		case json::value_t::string:
+			size += sizeof(std::string) + document.get_ref<const std::string&>().capacity();
+			break;
+		default:
+			break;
+	}
+
+	return size;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include "Tools/json.hpp"
+
+/*
+ *      MemoryBudget - rozliczanie pamięci zajmowanej przez zasoby
+ *  Każda kategoria liczona jest osobno dla GPU (tekstury, bufory wierzchołków) oraz CPU (kopie
+ *  wierzchołków, próbki dźwięków, dokumenty JSON, stany Lua). Wartości to rozmiary samych danych,
+ *  bez narzutu sterownika i alokatora - służą do porównań i pilnowania limitów, nie do profilowania.
+ *
+ *  Limity (w MiB) można podać w GameContent/MemoryBudget.json, np. {"VertexBuffers": 64}.
+ *  Po przekroczeniu limitu AssetManager zwalnia nieużywane bufory map i dźwięków.
+ */
+enum class MemoryCategory : unsigned {
+	Textures = 0,
+	VertexBuffers,
+	SoundBuffers,
+	Json,
+	Lua,
+	_DummyEnd
+};
+
+struct MemoryUsage {
+	std::size_t gpu {0};
+	std::size_t cpu {0};
+	unsigned count {0};
+
+	std::size_t total() const { return gpu + cpu; }
+
+	MemoryUsage& operator+=(const MemoryUsage& other) {
+		gpu += other.gpu;
+		cpu += other.cpu;
+		count += other.count;
+		return *this;
+	}
+};
+
+struct MemoryReport {
+	std::array<MemoryUsage, (unsigned)MemoryCategory::_DummyEnd> categories {};
+
+	MemoryUsage& operator[](MemoryCategory category) { return categories[(unsigned)category]; }
+	const MemoryUsage& operator[](MemoryCategory category) const { return categories[(unsigned)category]; }
+
+	std::size_t gpuTotal() const;
+	std::size_t cpuTotal() const;
+};
+
+class MemoryBudget {
+	//  0 - brak limitu
+	std::array<std::size_t, (unsigned)MemoryCategory::_DummyEnd> budgets {};
+
+	static MemoryBudget& get() {
+		static MemoryBudget budget;
+		return budget;
+	}
+public:
+	static std::size_t getBudget(MemoryCategory category) {
+		return get().budgets[(unsigned)category];
+	}
+
+	static void setBudget(MemoryCategory category, std::size_t bytes) {
+		get().budgets[(unsigned)category] = bytes;
+	}
+
+	static bool exceeded(MemoryCategory category, const MemoryUsage& usage) {
+		const auto budget = getBudget(category);
+		return budget != 0 && usage.total() > budget;
+	}
+
+	static void configure(const nlohmann::json& config);
+
+	static const char* categoryName(MemoryCategory category);
+	static MemoryCategory categoryFromName(const std::string& name);
+
+	/*
+	 *  Szacunkowy rozmiar dokumentu JSON w pamięci (węzły, klucze i napisy)
+	 */
+	static std::size_t estimateJson(const nlohmann::json& document);
+};
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Profiler.hpp"
+#include "Tools/json.hpp"
+
+std::atomic<bool> Profiler::s_enabled {false};
+
+/*
+ *  Bufor cykliczny jednego wątku. Zapisuje do niego tylko właściciel, więc blokada jest
+ *  praktycznie zawsze wolna - czeka na nią jedynie odczyt (nakładka, zapis śladu).
+ */
+struct ThreadBuffer {
+	std::mutex mutex;
+	std::array<Profiler::Event, Profiler::eventCapacity> events;
+	std::uint64_t written {0};
+	std::string name;
+	unsigned id {0};
+	unsigned depth {0};	//  tylko wątek-właściciel
+
+	template<class Visitor>
+	void visit(Visitor&& visitor) {
+		std::lock_guard<std::mutex> lock(mutex);
+		const std::uint64_t first = written > events.size() ? written - events.size() : 0;
+		for(auto i = first; i < written; ++i)
+			visitor(events[i % events.size()]);
+	}
+};
+
+static const auto s_epoch = std::chrono::steady_clock::now();
+
+static std::mutex s_registry_mutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> s_threads;	//  bufory zakończonych wątków zostają, do zapisu śladu
+static thread_local ThreadBuffer* t_buffer = nullptr;
+static thread_local const char* t_thread_name = nullptr;
+
+//  Klatki - tylko główny wątek
+static std::array<std::uint64_t, Profiler::frameCapacity> s_frame_starts {};
+static std::uint64_t s_frames = 0;
+static ThreadBuffer* s_main_buffer = nullptr;
+
+/*
+ *  Bufor tworzony jest przy pierwszym znaczniku wątku - wątki, które nic nie mierzą,
+ *  nie zajmują pamięci
+ */
+static ThreadBuffer& threadBuffer() {
+	if(!t_buffer) {
+		std::lock_guard<std::mutex> lock(s_registry_mutex);
+		s_threads.push_back(std::make_unique<ThreadBuffer>());
+		t_buffer = s_threads.back().get();
+		t_buffer->id = (unsigned)s_threads.size() - 1;
+		t_buffer->name = t_thread_name ? t_thread_name : "Thread " + std::to_string(t_buffer->id);
+	}
+	return *t_buffer;
+}
+
+void Profiler::setEnabled(bool enabled) {
+	//  Przerwa w pomiarach nie może wyglądać jak jedna bardzo długa klatka
+	if(enabled && !Profiler::enabled())
+		s_frames = 0;
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const char* name) {
+	t_thread_name = name;
+	if(t_buffer) {
+		std::lock_guard<std::mutex> lock(t_buffer->mutex);
+		t_buffer->name = name;
+	}
+}
+
+std::uint64_t Profiler::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+unsigned Profiler::enter() {
+	return threadBuffer().depth++;
+}
+
+void Profiler::record(const char* name, std::uint64_t start, std::uint64_t end, unsigned depth) {
+	auto& buffer = threadBuffer();
+	buffer.depth = depth;
+
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.events[buffer.written % buffer.events.size()] = Event{name, start, end - start, depth};
+	++buffer.written;
+}
+
+void Profiler::beginFrame() {
+	if(!enabled()) return;
+
+	if(!s_main_buffer) {
+		if(!t_thread_name) setThreadName("Main");
+		s_main_buffer = &threadBuffer();
+	}
+	s_frame_starts[s_frames % s_frame_starts.size()] = now();
+	++s_frames;
+}
+
+std::vector<float> Profiler::frameTimes() {
+	std::vector<float> times;
+	const std::uint64_t first = s_frames > s_frame_starts.size() ? s_frames - s_frame_starts.size() + 1 : 1;
+	for(auto i = first; i < s_frames; ++i) {
+		const auto duration = s_frame_starts[i % s_frame_starts.size()] - s_frame_starts[(i - 1) % s_frame_starts.size()];
+		times.push_back(duration / 1e6f);
+	}
+	return times;
+}
+
+std::vector<Profiler::ScopeStats> Profiler::topScopes(unsigned frames, unsigned count) {
+	std::vector<ScopeStats> result;
+	if(!s_main_buffer || s_frames == 0) return result;
+
+	frames = std::min<std::uint64_t>({frames, s_frames, s_frame_starts.size()});
+	const auto from = s_frame_starts[(s_frames - frames) % s_frame_starts.size()];
+
+	std::unordered_map<std::string, ScopeStats> stats;
+	s_main_buffer->visit([&stats, from](const Event& event) {
+		if(event.start < from) return;
+
+		auto& entry = stats[event.name];
+		const double ms = event.duration / 1e6;
+		entry.totalMs += ms;
+		entry.maxMs = std::max(entry.maxMs, ms);
+		++entry.calls;
+	});
+
+	for(auto& [name, entry] : stats) {
+		entry.name = name;
+		result.push_back(std::move(entry));
+	}
+	std::sort(result.begin(), result.end(), [](const ScopeStats& a, const ScopeStats& b) {
+		return a.totalMs > b.totalMs;
+	});
+	if(result.size() > count) result.resize(count);
+	return result;
+}
+
+/*
+ *  Zapis w formacie Chrome trace (zdarzenia "X" - pełne, z czasem trwania w µs)
+ */
+bool Profiler::writeChromeTrace(const std::string& path) {
+	std::ofstream file(path, std::ios::trunc);
+	if(!file.good()) {
+		std::cerr << "Profiler::writeChromeTrace() could not open '" << path << "' for writing\n";
+		return false;
+	}
+
+	unsigned written = 0;
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	std::lock_guard<std::mutex> lock(s_registry_mutex);
+	bool first = true;
+	for(auto& thread : s_threads) {
+		std::string name;
+		{
+			std::lock_guard<std::mutex> threadLock(thread->mutex);
+			name = thread->name;
+		}
+		file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->id
+		     << ",\"args\":{\"name\":" << nlohmann::json(name).dump() << "}}";
+		first = false;
+
+		thread->visit([&file, &thread, &written](const Event& event) {
+			file << ",\n{\"name\":" << nlohmann::json(event.name).dump() << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->id
+			     << ",\"ts\":" << event.start / 1e3 << ",\"dur\":" << event.duration / 1e3 << "}";
+			++written;
+		});
+	}
+	file << "\n]}\n";
+	file.close();
+
+	if(!file) {
+		std::cerr << "Profiler::writeChromeTrace() failed writing '" << path << "'\n";
+		return false;
+	}
+	std::cout << "Profiler/ Wrote " << written << " events to '" << path << "'\n";
+	return true;
+}
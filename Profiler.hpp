@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ *      Profiler - pomiar czasu faz klatki
+ *  Znaczniki PROFILE_SCOPE("nazwa") mierzą czas do końca bloku i zapisują go do bufora
+ *  cyklicznego wątku, który je wywołał (każdy wątek ma własny bufor, więc wątki nie blokują się
+ *  nawzajem). Zebrane dane można oglądać na żywo (ProfilerOverlay) lub zapisać w formacie
+ *  Chrome trace (chrome://tracing, Perfetto).
+ *
+ *  Wyłączony profiler kosztuje jeden odczyt flagi na znacznik. Zbudowany bez RPG_PROFILING
+ *  (opcja CMake) nie kosztuje nic - znaczniki znikają w preprocesorze.
+ *  Nazwy znaczników muszą być literałami - zapamiętywany jest sam wskaźnik.
+ */
+class Profiler {
+public:
+	struct Event {
+		const char* name;
+		std::uint64_t start;	//  ns od uruchomienia profilera
+		std::uint64_t duration;
+		std::uint32_t depth;
+	};
+
+	struct ScopeStats {
+		std::string name;
+		double totalMs {0.0};
+		double maxMs {0.0};
+		unsigned calls {0};
+	};
+
+	static constexpr unsigned eventCapacity = 16384;
+	static constexpr unsigned frameCapacity = 240;
+
+	static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+	static void setEnabled(bool enabled);
+
+	/*
+	 *  Początek nowej klatki - wołane z głównego wątku, raz na obieg pętli gry
+	 */
+	static void beginFrame();
+	static void setThreadName(const char* name);
+
+	static std::uint64_t now();
+	static unsigned enter();
+	static void record(const char* name, std::uint64_t start, std::uint64_t end, unsigned depth);
+
+	//  Czasy ostatnich klatek w ms, od najstarszej
+	static std::vector<float> frameTimes();
+	//  Najdroższe znaczniki głównego wątku z ostatnich klatek, posortowane po łącznym czasie
+	static std::vector<ScopeStats> topScopes(unsigned frames, unsigned count);
+
+	static bool writeChromeTrace(const std::string& path);
+private:
+	static std::atomic<bool> s_enabled;
+};
+
+class ProfileScope {
+	const char* name;
+	std::uint64_t start {0};
+	unsigned depth {0};
+public:
+	explicit ProfileScope(const char* scopeName)
+	: name(Profiler::enabled() ? scopeName : nullptr) {
+		if(name) {
+			depth = Profiler::enter();
+			start = Profiler::now();
+		}
+	}
+
+	~ProfileScope() {
+		if(name) Profiler::record(name, start, Profiler::now(), depth);
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#ifdef RPG_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::setThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
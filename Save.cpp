@@ -0,0 +1,246 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include "Save.hpp"
+#include "SaveFormat.hpp"
+#include "Profiler.hpp"
+
+SaveWriter::SaveWriter() {
+	worker = std::thread(&SaveWriter::run, this);
+}
+
+SaveWriter::~SaveWriter() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_one();
+	if(worker.joinable())
+		worker.join();
+}
+
+void SaveWriter::submit(nlohmann::json snapshot, const std::string& path) {
+	auto& writer = get();
+	if(writer.discard) return;
+	//  Pełny zapis obejmuje wszystkie dotychczasowe zmiany
+	std::vector<char> covered;
+	covered.swap(writer.recorded);
+	writer.journalSize = 0;
+	snapshot[SaveFormat::generationKey] = ++writer.generation;
+	{
+		std::lock_guard<std::mutex> lock(writer.mutex);
+		//  Poprzednia, jeszcze niezapisana kopia zostaje zastąpiona nowszą
+		if(!writer.hasWork())
+			++writer.inFlight;
+		writer.pending = std::make_unique<nlohmann::json>(std::move(snapshot));
+		writer.pendingPath = path;
+		//  Rekordy zastąpione pełnym zapisem czekają na jego wynik - po nieudanym trafią jednak do dziennika
+		writer.pendingCovered.insert(writer.pendingCovered.end(), writer.pendingAppend.begin(), writer.pendingAppend.end());
+		writer.pendingCovered.insert(writer.pendingCovered.end(), covered.begin(), covered.end());
+		writer.pendingAppend.clear();
+	}
+	writer.wake.notify_one();
+}
+
+void SaveWriter::record(const std::string& key, const nlohmann::json& before, const nlohmann::json& after) {
+	if(get().discard) return;
+	SaveFormat::journalDiff(get().recorded, key, before, after);
+}
+
+void SaveWriter::recordMember(const std::string& key, const std::string& member, const nlohmann::json& value) {
+	if(get().discard) return;
+	SaveFormat::journalSetMember(get().recorded, key, member, value);
+}
+
+void SaveWriter::commitJournal(const nlohmann::json& document) {
+	auto& writer = get();
+	if(writer.recorded.empty()) return;
+
+	if(writer.journalSize + writer.recorded.size() > compactThreshold) {
+		submit(document);
+		return;
+	}
+
+	writer.journalSize += writer.recorded.size();
+	{
+		std::lock_guard<std::mutex> lock(writer.mutex);
+		if(!writer.hasWork())
+			++writer.inFlight;
+		writer.pendingAppend.insert(writer.pendingAppend.end(), writer.recorded.begin(), writer.recorded.end());
+	}
+	writer.recorded.clear();
+	writer.wake.notify_one();
+}
+
+static std::uint32_t documentGeneration(const nlohmann::json& document) {
+	if(!document.is_object()) return 0;
+	auto it = document.find(SaveFormat::generationKey);
+	return (it != document.end() && it->is_number_unsigned()) ? it->get<std::uint32_t>() : 0;
+}
+
+unsigned SaveWriter::replayJournal(nlohmann::json& document) {
+	auto& writer = get();
+	const auto generation = documentGeneration(document);
+	writer.generation = generation;
+	{
+		std::lock_guard<std::mutex> lock(writer.mutex);
+		writer.journalGeneration = generation;
+	}
+
+	std::ifstream file{journalPath(), std::ios::binary};
+	if(!file.good()) return 0;
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	file.close();
+
+	std::uint32_t journalGeneration = 0;
+	if(!SaveFormat::journalGeneration(data, journalGeneration)) {
+		if(!data.empty())
+			std::cerr << "SaveWriter::replayJournal()/ Unreadable journal header, discarding it\n";
+		resetJournal();
+		return 0;
+	}
+	//  Dziennik sprzed ostatniego pełnego zapisu - jego zmiany są już w zapisie, a odtworzenie cofnęłoby nowsze
+	if(journalGeneration != generation) {
+		std::cerr << "SaveWriter::replayJournal()/ Journal belongs to save #" << journalGeneration
+		          << ", loaded save is #" << generation << ", discarding it\n";
+		resetJournal();
+		return 0;
+	}
+
+	std::size_t consumed = 0;
+	const auto applied = SaveFormat::replayJournal(data, document, consumed);
+	//  Urwany ostatni rekord jest odcinany - inaczej kolejne rekordy dopisane za nim byłyby nieosiągalne
+	if(consumed < data.size() && !writer.discard) {
+		std::error_code ec;
+		std::filesystem::resize_file(journalPath(), consumed, ec);
+		if(ec) {
+			std::cerr << "SaveWriter::replayJournal()/ Could not truncate journal, discarding it\n";
+			std::cerr << "Details: " << ec.message() << "\n";
+			resetJournal();
+			consumed = 0;
+		}
+	}
+	writer.journalSize = consumed;
+	return applied;
+}
+
+void SaveWriter::flush() {
+	auto& writer = get();
+	std::unique_lock<std::mutex> lock(writer.mutex);
+	writer.idle.wait(lock, [&writer]() { return writer.inFlight.load() == 0; });
+}
+
+void SaveWriter::run() {
+	PROFILE_THREAD("Save writer");
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true) {
+		wake.wait(lock, [this]() { return stopping || hasWork(); });
+		//  Zapis oczekujący w chwili zamykania gry jest jeszcze dokańczany
+		if(!hasWork() && stopping) return;
+
+		auto snapshot = std::move(pending);
+		auto path = pendingPath;
+		std::vector<char> append;
+		append.swap(pendingAppend);
+		std::vector<char> covered;
+		covered.swap(pendingCovered);
+		lock.unlock();
+
+		//  Kolejność ma znaczenie - rekordy dopisywane po pełnym zapisie są zawsze od niego nowsze
+		if(snapshot) {
+			PROFILE_SCOPE("Save write");
+			const auto start = std::chrono::steady_clock::now();
+			const auto bytes = SaveFormat::encode(*snapshot);
+			const auto encoded = std::chrono::steady_clock::now();
+			const bool ok = writeAtomically(bytes, path);
+			const auto written = std::chrono::steady_clock::now();
+			lastFailed = !ok;
+
+			if(ok) {
+				resetJournal();
+				journalGeneration = documentGeneration(*snapshot);
+				using ms = std::chrono::duration<double, std::milli>;
+				std::cout << "Game saved successfully (" << bytes.size() << " bytes, encode "
+				          << ms(encoded - start).count() << " ms, write " << ms(written - encoded).count() << " ms)\n";
+			} else {
+				//  Plik zapisu i dziennik na dysku są nadal poprzednie - zmiany objęte nieudanym zapisem dopisujemy do dziennika
+				append.insert(append.begin(), covered.begin(), covered.end());
+			}
+			if(jsonExport)
+				SaveFormat::exportJson(*snapshot, exportPath());
+		}
+
+		if(!append.empty()) {
+			PROFILE_SCOPE("Journal append");
+			lastFailed = !appendJournal(append, journalGeneration);
+		}
+
+		lock.lock();
+		--inFlight;
+		idle.notify_all();
+	}
+}
+
+/*
+ *  Dopisuje rekordy na końcu dziennika, tworząc go (z nagłówkiem) jeśli nie istnieje
+ */
+bool SaveWriter::appendJournal(const std::vector<char>& records, std::uint32_t generation) {
+	std::error_code ec;
+	const bool fresh = !std::filesystem::exists(journalPath(), ec) || std::filesystem::file_size(journalPath(), ec) == 0;
+
+	std::ofstream file{journalPath(), std::ios::app | std::ios::binary};
+	if(!file.good()) {
+		std::cerr << "Failed appending to save journal '" << journalPath() << "'\n";
+		return false;
+	}
+	if(fresh) {
+		const auto header = SaveFormat::journalHeader(generation);
+		file.write(header.data(), header.size());
+	}
+	file.write(records.data(), records.size());
+	file.flush();
+	return file.good();
+}
+
+/*
+ *  Po udanym pełnym zapisie dziennik jest pusty. Awaria przed tym krokiem zostawia dziennik
+ *  z numerem poprzedniego zapisu, który replayJournal rozpozna i odrzuci.
+ */
+void SaveWriter::resetJournal() {
+	if(get().discard) return;
+	std::error_code ec;
+	std::filesystem::remove(journalPath(), ec);
+}
+
+/*
+ *  Zapisuje dokument do pliku tymczasowego i podmienia nim plik docelowy
+ */
+bool SaveWriter::writeAtomically(const std::vector<char>& bytes, const std::string& path) {
+	const std::string tempPath = path + ".tmp";
+	{
+		std::ofstream file{tempPath, std::ios::trunc | std::ios::binary};
+		if(!file.good()) {
+			std::cerr << "Failed saving savefile to file: could not open '" << tempPath << "'\n";
+			return false;
+		}
+		file.write(bytes.data(), bytes.size());
+		file.flush();
+		if(!file.good()) {
+			std::cerr << "Failed saving savefile to file: write to '" << tempPath << "' failed\n";
+			file.close();
+			std::remove(tempPath.c_str());
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempPath, path, ec);
+	if(ec) {
+		std::cerr << "Failed saving savefile to file: could not replace '" << path << "'\n";
+		std::cerr << "Details: " << ec.message() << "\n";
+		std::remove(tempPath.c_str());
+		return false;
+	}
+	return true;
+}
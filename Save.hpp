@@ -1,8 +1,121 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "JsonOverloads.hpp"
 #include "Tools/json.hpp"
 
+/*
+ *      SaveWriter - zapis gry w tle
+ *  Główny wątek przekazuje jedynie kopię dokumentu, a serializacja i zapis odbywają się
+ *  na osobnym wątku. Plik zapisywany jest najpierw obok docelowego, a następnie podmieniany
+ *  przez rename, więc przerwany zapis nigdy nie niszczy poprzedniego stanu gry.
+ *  Kolejne zapisy zlecone w trakcie trwającego są łączone - zapisywana jest tylko najnowsza kopia.
+ *
+ *  Między pełnymi zapisami zmiany dokumentu trafiają do dziennika (Savegame.journal) jako małe
+ *  rekordy dopisywane na końcu pliku. Gdy dziennik urośnie, kolejny commit zleca pełny zapis,
+ *  który zastępuje zarówno plik zapisu jak i dziennik. Każdy pełny zapis dostaje kolejny numer,
+ *  a dziennik pamięta numer zapisu, po którym powstał.
+ */
+class SaveWriter {
+	std::thread worker;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable idle;
+	std::unique_ptr<nlohmann::json> pending;
+	std::string pendingPath;
+	std::vector<char> pendingAppend;
+	//  Rekordy zastąpione oczekującym pełnym zapisem - odrzucane dopiero, gdy zapis się uda
+	std::vector<char> pendingCovered;
+	bool stopping {false};
+
+	//  Rekordy dziennika jeszcze nieprzekazane do zapisu (tylko główny wątek)
+	std::vector<char> recorded;
+	std::size_t journalSize {0};
+	//  Numer ostatniego zleconego pełnego zapisu (główny wątek) i zapisu na dysku, za którym idzie dziennik (wątek zapisu)
+	std::uint32_t generation {0};
+	std::uint32_t journalGeneration {0};
+	static constexpr std::size_t compactThreshold = 64 * 1024;
+
+	std::atomic<unsigned> inFlight {0};
+	std::atomic<bool> lastFailed {false};
+	std::atomic<bool> discard {false};
+	std::atomic<bool> jsonExport {
+#ifndef NDEBUG
+		true
+#else
+		false
+#endif
+	};
+
+	SaveWriter();
+	~SaveWriter();
+
+	void run();
+	static bool writeAtomically(const std::vector<char>& bytes, const std::string& path);
+	static bool appendJournal(const std::vector<char>& records, std::uint32_t generation);
+	static void resetJournal();
+	bool hasWork() const { return pending || !pendingAppend.empty(); }
+
+	static SaveWriter& get() {
+		static SaveWriter writer;
+		return writer;
+	}
+public:
+	static const char* defaultPath() { return "GameContent/Savegame.sav"; }
+	static const char* legacyPath() { return "GameContent/Savegame.json"; }
+	static const char* exportPath() { return "GameContent/Savegame.export.json"; }
+	static const char* journalPath() { return "GameContent/Savegame.journal"; }
+
+	static void submit(nlohmann::json snapshot, const std::string& path = defaultPath());
+
+	/*
+	 *  Zapamiętuje zmianę klucza dokumentu jako rekordy dziennika (różnica before -> after)
+	 */
+	static void record(const std::string& key, const nlohmann::json& before, const nlohmann::json& after);
+	static void recordMember(const std::string& key, const std::string& member, const nlohmann::json& value);
+
+	/*
+	 *  Utrwala zapamiętane zmiany - dopisuje je do dziennika w tle, lub (gdy dziennik jest
+	 *  już duży) zleca pełny zapis dokumentu, czyli kompaktację
+	 */
+	static void commitJournal(const nlohmann::json& document);
+
+	/*
+	 *  Odtwarza dziennik z dysku na wczytanym dokumencie, zwraca liczbę rekordów.
+	 *  Dziennik należący do innego pełnego zapisu jest usuwany bez odtwarzania,
+	 *  a urwany ostatni rekord odcinany.
+	 */
+	static unsigned replayJournal(nlohmann::json& document);
+
+	/*
+	 *  Czy jakiś zapis jest jeszcze w kolejce lub w trakcie - nie blokuje
+	 */
+	static bool inProgress() { return get().inFlight.load() != 0; }
+	static bool lastSaveFailed() { return get().lastFailed.load(); }
+
+	/*
+	 *  Dodatkowy, czytelny zrzut zapisu w JSON (domyślnie włączony w buildach debug)
+	 */
+	static void setJsonExport(bool enabled) { get().jsonExport = enabled; }
+
+	/*
+	 *  Odrzuca wszystkie zapisy i nie zmienia plików na dysku - dla narzędzi działających
+	 *  na zapisie gry bez prawa do jego zmiany (np. benchmarki)
+	 */
+	static void setDiscard(bool enabled) { get().discard = enabled; }
+
+	/*
+	 *  Czeka na zakończenie wszystkich zleconych zapisów (np. przy wyjściu z gry)
+	 */
+	static void flush();
+};
+
 class Savefile {
 	nlohmann::json& contents;
 public:
@@ -20,20 +133,49 @@ public:
 
 	template<class T>
 	void set(const std::string& key, const T& value) {
-		contents[key] = value;
+		nlohmann::json updated = value;
+		auto current = contents.find(key);
+		SaveWriter::record(key, current != contents.end() ? *current : nlohmann::json{}, updated);
+		contents[key] = std::move(updated);
 	}
 
 	bool exists(const std::string& key) {
 		return contents.find(key) != contents.end();
 	}
 
+	/*
+	 *  Flagi skryptów - liczby całkowite pod kluczem 'scriptFlags', nieistniejąca flaga to 0
+	 */
+	int getFlag(const std::string& name) const {
+		auto flags = contents.find("scriptFlags");
+		if(flags == contents.end() || !flags->is_object()) return 0;
+		auto flag = flags->find(name);
+		return (flag != flags->end() && flag->is_number()) ? flag->get<int>() : 0;
+	}
+
+	void setFlag(const std::string& name, int value) {
+		auto& flags = contents["scriptFlags"];
+		if(!flags.is_object()) flags = nlohmann::json::object();
+		flags[name] = value;
+		SaveWriter::recordMember("scriptFlags", name, value);
+	}
+
+	/*
+	 *  Zleca zapis aktualnego stanu - sama kopia dokumentu wykonywana jest tutaj,
+	 *  serializacja i zapis na dysk dzieją się w tle
+	 */
 	void saveToFile() {
-		std::ofstream file{"GameContent/Savegame.json"};
-		if(!file.good()) {
-			std::cerr << "Failed saving savefile to file\n";
-			return;
-		}
-		file << contents.dump(1, '\t');
-		file.close();
+		SaveWriter::submit(contents);
+	}
+
+	/*
+	 *  Autozapis - utrwala jedynie zmiany od ostatniego zapisu
+	 */
+	void commit() {
+		SaveWriter::commitJournal(contents);
+	}
+
+	static bool saveInProgress() {
+		return SaveWriter::inProgress();
 	}
 };
\ No newline at end of file
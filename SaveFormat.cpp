@@ -0,0 +1,459 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include "SaveFormat.hpp"
+
+static const char s_magic[4] = {'R', 'P', 'G', 'S'};
+static const char s_journal_magic[4] = {'R', 'P', 'G', 'J'};
+
+static constexpr std::uint32_t makeTag(char a, char b, char c, char d) {
+	return (std::uint32_t)(unsigned char)a | ((std::uint32_t)(unsigned char)b << 8) |
+	       ((std::uint32_t)(unsigned char)c << 16) | ((std::uint32_t)(unsigned char)d << 24);
+}
+
+static constexpr std::uint32_t s_tag_player    = makeTag('P','L','Y','R');
+static constexpr std::uint32_t s_tag_stats     = makeTag('S','T','A','T');
+static constexpr std::uint32_t s_tag_info      = makeTag('I','N','F','O');
+static constexpr std::uint32_t s_tag_backpack  = makeTag('B','P','C','K');
+static constexpr std::uint32_t s_tag_equipment = makeTag('E','Q','I','P');
+static constexpr std::uint32_t s_tag_flags     = makeTag('F','L','A','G');
+static constexpr std::uint32_t s_tag_extra     = makeTag('X','T','R','A');
+static constexpr std::uint32_t s_tag_generation = makeTag('G','E','N','R');
+
+//  Maska pól bloku 'PLYR'
+enum : std::uint8_t {
+	PlayerHasName = 1,
+	PlayerHasMap  = 2,
+	PlayerHasPos  = 4
+};
+
+//  Operacje rekordów dziennika
+enum : std::uint8_t {
+	JournalSet       = 1,
+	JournalSetMember = 2,
+	JournalSetIndex  = 3
+};
+
+struct ByteWriter {
+	std::vector<char>& out;
+
+	void u8(std::uint8_t v) { out.push_back((char)v); }
+	void u16(std::uint16_t v) { u8(v & 0xFF); u8(v >> 8); }
+	void u32(std::uint32_t v) { u16(v & 0xFFFF); u16(v >> 16); }
+	void i32(std::int32_t v) { u32((std::uint32_t)v); }
+	void str(const std::string& s) {
+		const auto len = (std::uint16_t)std::min<std::size_t>(s.size(), std::numeric_limits<std::uint16_t>::max());
+		u16(len);
+		out.insert(out.end(), s.begin(), s.begin() + len);
+	}
+
+	std::size_t beginChunk(std::uint32_t tag) {
+		u32(tag);
+		u32(0);
+		return out.size();
+	}
+	void endChunk(std::size_t start) {
+		const auto length = (std::uint32_t)(out.size() - start);
+		for(unsigned i = 0; i < 4; ++i)
+			out[start - 4 + i] = (char)((length >> (8 * i)) & 0xFF);
+	}
+};
+
+struct ByteReader {
+	const char* data;
+	std::size_t size;
+	std::size_t pos {0};
+	bool bad {false};
+
+	bool has(std::size_t n) {
+		if(pos + n > size) bad = true;
+		return !bad;
+	}
+	bool atEnd() const { return bad || pos >= size; }
+
+	std::uint8_t u8() { return has(1) ? (std::uint8_t)data[pos++] : 0; }
+	std::uint16_t u16() { std::uint16_t lo = u8(); return lo | (std::uint16_t)(u8() << 8); }
+	std::uint32_t u32() { std::uint32_t lo = u16(); return lo | ((std::uint32_t)u16() << 16); }
+	std::int32_t i32() { return (std::int32_t)u32(); }
+	std::string str() {
+		const auto len = u16();
+		if(!has(len)) return {};
+		std::string s(data + pos, len);
+		pos += len;
+		return s;
+	}
+};
+
+static void writeIntMap(ByteWriter& w, const nlohmann::json& object) {
+	std::uint16_t count = 0;
+	for(auto it = object.begin(); it != object.end(); ++it)
+		if(it.value().is_number()) ++count;
+
+	w.u16(count);
+	for(auto it = object.begin(); it != object.end(); ++it) {
+		if(!it.value().is_number()) continue;
+		w.str(it.key());
+		w.i32(it.value().get<std::int32_t>());
+	}
+}
+
+static nlohmann::json readIntMap(ByteReader& r) {
+	nlohmann::json object = nlohmann::json::object();
+	const auto count = r.u16();
+	for(unsigned i = 0; i < count && !r.bad; ++i) {
+		auto key = r.str();
+		object[key] = r.i32();
+	}
+	return object;
+}
+
+bool SaveFormat::isBinary(const std::vector<char>& data) {
+	return data.size() >= sizeof(s_magic) && std::memcmp(data.data(), s_magic, sizeof(s_magic)) == 0;
+}
+
+std::vector<char> SaveFormat::encode(const nlohmann::json& document) {
+	std::vector<char> out;
+	ByteWriter w{out};
+	out.insert(out.end(), s_magic, s_magic + sizeof(s_magic));
+	w.u16(version);
+	w.u16(0);	//zarezerwowane
+
+	if(!document.is_object()) return out;
+
+	//  Klucze obsługiwane przez bloki, reszta trafia do 'XTRA'
+	nlohmann::json extra = document;
+
+	{
+		std::uint8_t mask = 0;
+		const auto name = document.find("playerName");
+		const auto map = document.find("playerCurrentMap");
+		const auto pos = document.find("playerCurrentPos");
+		if(name != document.end() && name->is_string()) mask |= PlayerHasName;
+		if(map != document.end() && map->is_string()) mask |= PlayerHasMap;
+		if(pos != document.end() && pos->is_array() && pos->size() == 2) mask |= PlayerHasPos;
+
+		auto chunk = w.beginChunk(s_tag_player);
+		w.u8(mask);
+		w.str(mask & PlayerHasName ? name->get<std::string>() : std::string{});
+		w.str(mask & PlayerHasMap ? map->get<std::string>() : std::string{});
+		w.u32(mask & PlayerHasPos ? (*pos)[0].get<std::uint32_t>() : 0);
+		w.u32(mask & PlayerHasPos ? (*pos)[1].get<std::uint32_t>() : 0);
+		w.endChunk(chunk);
+
+		if(mask & PlayerHasName) extra.erase("playerName");
+		if(mask & PlayerHasMap) extra.erase("playerCurrentMap");
+		if(mask & PlayerHasPos) extra.erase("playerCurrentPos");
+	}
+
+	const std::pair<const char*, std::uint32_t> intMaps[] = {
+		{"playerStats", s_tag_stats},
+		{"playerInfo", s_tag_info},
+		{"scriptFlags", s_tag_flags}
+	};
+	for(auto& [key, tag] : intMaps) {
+		const auto it = document.find(key);
+		if(it == document.end() || !it->is_object()) continue;
+
+		auto chunk = w.beginChunk(tag);
+		writeIntMap(w, *it);
+		w.endChunk(chunk);
+		extra.erase(key);
+	}
+
+	//  Plecak zapisywany rzadko - tylko zajęte sloty
+	const auto backpack = document.find("playerBackpack");
+	if(backpack != document.end() && backpack->is_array()) {
+		std::uint16_t used = 0;
+		for(auto& slot : *backpack)
+			if(slot.is_array() && slot.size() == 2 && slot[1].is_number() && slot[1].get<unsigned>() != 0) ++used;
+
+		auto chunk = w.beginChunk(s_tag_backpack);
+		w.u16((std::uint16_t)backpack->size());
+		w.u16(used);
+		for(std::size_t i = 0; i < backpack->size(); ++i) {
+			const auto& slot = (*backpack)[i];
+			if(!slot.is_array() || slot.size() != 2 || !slot[1].is_number() || slot[1].get<unsigned>() == 0) continue;
+			w.u16((std::uint16_t)i);
+			w.str(slot[0].is_string() ? slot[0].get<std::string>() : std::string{});
+			w.u16((std::uint16_t)slot[1].get<unsigned>());
+		}
+		w.endChunk(chunk);
+		extra.erase("playerBackpack");
+	}
+
+	const auto equipment = document.find("playerEquipment");
+	if(equipment != document.end() && equipment->is_array()) {
+		auto chunk = w.beginChunk(s_tag_equipment);
+		w.u8((std::uint8_t)equipment->size());
+		for(auto& slot : *equipment)
+			w.str(slot.is_string() ? slot.get<std::string>() : std::string{});
+		w.endChunk(chunk);
+		extra.erase("playerEquipment");
+	}
+
+	const auto generation = document.find(generationKey);
+	if(generation != document.end() && generation->is_number_unsigned()) {
+		auto chunk = w.beginChunk(s_tag_generation);
+		w.u32(generation->get<std::uint32_t>());
+		w.endChunk(chunk);
+		extra.erase(generationKey);
+	}
+
+	if(!extra.empty()) {
+		auto packed = nlohmann::json::to_msgpack(extra);
+		auto chunk = w.beginChunk(s_tag_extra);
+		out.insert(out.end(), packed.begin(), packed.end());
+		w.endChunk(chunk);
+	}
+
+	return out;
+}
+
+bool SaveFormat::decode(const std::vector<char>& data, nlohmann::json& document) {
+	if(!isBinary(data)) return false;
+
+	ByteReader header{data.data(), data.size(), sizeof(s_magic)};
+	const auto fileVersion = header.u16();
+	header.u16();
+	if(header.bad) return false;
+	if(fileVersion > version)
+		std::cerr << "SaveFormat::decode()/ Savegame version " << fileVersion << " is newer than supported " << version << ", unknown data will be skipped\n";
+
+	document = nlohmann::json::object();
+	ByteReader chunks = header;
+	while(!chunks.atEnd()) {
+		const auto tag = chunks.u32();
+		const auto length = chunks.u32();
+		if(!chunks.has(length)) break;
+
+		ByteReader r{data.data() + chunks.pos, length};
+		chunks.pos += length;
+
+		if(tag == s_tag_player) {
+			const auto mask = r.u8();
+			auto name = r.str();
+			auto map = r.str();
+			const auto x = r.u32();
+			const auto y = r.u32();
+			if(mask & PlayerHasName) document["playerName"] = name;
+			if(mask & PlayerHasMap) document["playerCurrentMap"] = map;
+			if(mask & PlayerHasPos) document["playerCurrentPos"] = {x, y};
+		} else if(tag == s_tag_stats) {
+			document["playerStats"] = readIntMap(r);
+		} else if(tag == s_tag_info) {
+			document["playerInfo"] = readIntMap(r);
+		} else if(tag == s_tag_flags) {
+			document["scriptFlags"] = readIntMap(r);
+		} else if(tag == s_tag_backpack) {
+			const auto slots = r.u16();
+			const auto used = r.u16();
+			auto backpack = nlohmann::json::array();
+			for(unsigned i = 0; i < slots; ++i)
+				backpack.push_back({"", 0});
+			for(unsigned i = 0; i < used && !r.bad; ++i) {
+				const auto index = r.u16();
+				auto designator = r.str();
+				const auto count = r.u16();
+				if(index < slots) backpack[index] = {designator, count};
+			}
+			document["playerBackpack"] = std::move(backpack);
+		} else if(tag == s_tag_equipment) {
+			const auto slots = r.u8();
+			auto equipment = nlohmann::json::array();
+			for(unsigned i = 0; i < slots && !r.bad; ++i)
+				equipment.push_back(r.str());
+			document["playerEquipment"] = std::move(equipment);
+		} else if(tag == s_tag_generation) {
+			document[generationKey] = r.u32();
+		} else if(tag == s_tag_extra) {
+			try {
+				auto extra = nlohmann::json::from_msgpack(r.data, r.data + r.size);
+				for(auto it = extra.begin(); it != extra.end(); ++it)
+					document[it.key()] = it.value();
+			} catch (std::exception& ex) {
+				std::cerr << "SaveFormat::decode()/ Corrupted extra data block, skipping\n";
+				std::cerr << "Details: " << ex.what() << "\n";
+			}
+		}
+		//  Nieznane bloki (z nowszej wersji gry) są pomijane
+
+		if(r.bad) {
+			std::cerr << "SaveFormat::decode()/ Truncated block in savegame\n";
+			return false;
+		}
+	}
+
+	return !chunks.bad;
+}
+
+std::vector<char> SaveFormat::journalHeader(std::uint32_t generation) {
+	std::vector<char> out;
+	ByteWriter w{out};
+	out.insert(out.end(), s_journal_magic, s_journal_magic + sizeof(s_journal_magic));
+	w.u16(version);
+	w.u16(0);	//zarezerwowane
+	w.u32(generation);
+	return out;
+}
+
+static bool isJournal(const std::vector<char>& data) {
+	return data.size() >= sizeof(s_journal_magic) && std::memcmp(data.data(), s_journal_magic, sizeof(s_journal_magic)) == 0;
+}
+
+bool SaveFormat::journalGeneration(const std::vector<char>& data, std::uint32_t& generation) {
+	if(!isJournal(data)) return false;
+
+	ByteReader header{data.data(), data.size(), sizeof(s_journal_magic)};
+	const auto journalVersion = header.u16();
+	header.u16();
+	generation = journalVersion >= 2 ? header.u32() : 0;
+	return !header.bad;
+}
+
+static void writeValue(std::vector<char>& out, const nlohmann::json& value) {
+	auto packed = nlohmann::json::to_msgpack(value);
+	out.insert(out.end(), packed.begin(), packed.end());
+}
+
+//  Rekord używa tego samego układu co bloki pliku zapisu: [operacja u8][długość u32][dane]
+static std::size_t beginRecord(ByteWriter& w, std::uint8_t op) {
+	w.u8(op);
+	w.u32(0);
+	return w.out.size();
+}
+
+void SaveFormat::journalSet(std::vector<char>& out, const std::string& key, const nlohmann::json& value) {
+	ByteWriter w{out};
+	auto record = beginRecord(w, JournalSet);
+	w.str(key);
+	writeValue(out, value);
+	w.endChunk(record);
+}
+
+void SaveFormat::journalSetMember(std::vector<char>& out, const std::string& key, const std::string& member, const nlohmann::json& value) {
+	ByteWriter w{out};
+	auto record = beginRecord(w, JournalSetMember);
+	w.str(key);
+	w.str(member);
+	writeValue(out, value);
+	w.endChunk(record);
+}
+
+void SaveFormat::journalSetIndex(std::vector<char>& out, const std::string& key, std::uint16_t index, const nlohmann::json& value) {
+	ByteWriter w{out};
+	auto record = beginRecord(w, JournalSetIndex);
+	w.str(key);
+	w.u16(index);
+	writeValue(out, value);
+	w.endChunk(record);
+}
+
+/*
+ *  Zapisuje jedynie zmienione pola obiektów i elementy tablic (np. pojedyncze sloty plecaka),
+ *  a całą wartość tylko gdy zmienił się jej kształt
+ */
+void SaveFormat::journalDiff(std::vector<char>& out, const std::string& key, const nlohmann::json& before, const nlohmann::json& after) {
+	if(before == after) return;
+
+	if(before.is_object() && after.is_object()) {
+		bool removed = false;
+		for(auto it = before.begin(); it != before.end() && !removed; ++it)
+			removed = after.find(it.key()) == after.end();
+
+		if(!removed) {
+			for(auto it = after.begin(); it != after.end(); ++it) {
+				auto old = before.find(it.key());
+				if(old == before.end() || *old != it.value())
+					journalSetMember(out, key, it.key(), it.value());
+			}
+			return;
+		}
+	} else if(before.is_array() && after.is_array() && before.size() == after.size() &&
+	          after.size() <= std::numeric_limits<std::uint16_t>::max()) {
+		for(std::size_t i = 0; i < after.size(); ++i) {
+			if(before[i] != after[i])
+				journalSetIndex(out, key, (std::uint16_t)i, after[i]);
+		}
+		return;
+	}
+
+	journalSet(out, key, after);
+}
+
+/*
+ *  Nakłada rekordy dziennika na dokument. Urwany ostatni rekord (awaria w trakcie dopisywania)
+ *  kończy odtwarzanie - wszystko przed nim jest kompletne.
+ */
+unsigned SaveFormat::replayJournal(const std::vector<char>& data, nlohmann::json& document, std::size_t& consumed) {
+	consumed = 0;
+	if(!isJournal(data)) {
+		if(!data.empty())
+			std::cerr << "SaveFormat::replayJournal()/ Not a save journal, ignoring\n";
+		return 0;
+	}
+
+	ByteReader records{data.data(), data.size(), sizeof(s_journal_magic)};
+	const auto journalVersion = records.u16();	//nieznane operacje są pomijane
+	records.u16();
+	if(journalVersion >= 2)
+		records.u32();	//numer zapisu - sprawdza SaveWriter::replayJournal
+	if(!records.bad)
+		consumed = records.pos;
+
+	if(!document.is_object())
+		document = nlohmann::json::object();
+
+	unsigned applied = 0;
+	while(!records.atEnd()) {
+		const auto op = records.u8();
+		const auto length = records.u32();
+		if(!records.has(length)) {
+			std::cerr << "SaveFormat::replayJournal()/ Journal ends with an incomplete record, ignoring it\n";
+			break;
+		}
+
+		ByteReader r{data.data() + records.pos, length};
+		records.pos += length;
+
+		try {
+			const auto key = r.str();
+			if(op == JournalSet) {
+				document[key] = nlohmann::json::from_msgpack(r.data + r.pos, r.data + r.size);
+			} else if(op == JournalSetMember) {
+				const auto member = r.str();
+				auto& target = document[key];
+				if(!target.is_object()) target = nlohmann::json::object();
+				target[member] = nlohmann::json::from_msgpack(r.data + r.pos, r.data + r.size);
+			} else if(op == JournalSetIndex) {
+				const auto index = r.u16();
+				auto& target = document[key];
+				if(!target.is_array()) target = nlohmann::json::array();
+				while(target.size() <= index) target.push_back(nullptr);
+				target[index] = nlohmann::json::from_msgpack(r.data + r.pos, r.data + r.size);
+			} else {
+				continue;
+			}
+		} catch (std::exception& ex) {
+			std::cerr << "SaveFormat::replayJournal()/ Corrupted record, stopping replay\n";
+			std::cerr << "Details: " << ex.what() << "\n";
+			break;
+		}
+
+		if(r.bad) break;
+		++applied;
+		consumed = records.pos;
+	}
+	return applied;
+}
+
+bool SaveFormat::exportJson(const nlohmann::json& document, const std::string& path) {
+	std::ofstream file{path, std::ios::trunc};
+	if(!file.good()) {
+		std::cerr << "SaveFormat::exportJson()/ Could not open '" << path << "'\n";
+		return false;
+	}
+	file << document.dump(1, '\t');
+	return file.good();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Tools/json.hpp"
+
+/*
+ *      SaveFormat - binarny format zapisu gry
+ *  Plik to nagłówek ('RPGS', wersja) oraz ciąg bloków [tag, długość, dane]. Każdy blok ma stały
+ *  układ pól; nowe pola dopisywane są zawsze na końcu bloku, a nowe dane trafiają do nowych bloków.
+ *  Starsza wersja gry pomija więc nieznane bloki i nadmiarowe bajty, a nowsza uzupełnia brakujące
+ *  pola wartościami domyślnymi.
+ *
+ *  Format koduje ten sam dokument, którego używa Savefile - klucze nieobsługiwane przez żaden blok
+ *  trafiają w całości do bloku 'XTRA' (MessagePack), więc nic nie jest gubione.
+ *  Wszystkie liczby zapisywane są w little-endian.
+ */
+class SaveFormat {
+public:
+	static constexpr std::uint16_t version = 2;
+
+	//  Numer pełnego zapisu - zapisywany w bloku 'GENR' i w nagłówku dziennika
+	static constexpr const char* generationKey = "saveGeneration";
+
+	static bool isBinary(const std::vector<char>& data);
+	static std::vector<char> encode(const nlohmann::json& document);
+	static bool decode(const std::vector<char>& data, nlohmann::json& document);
+
+	/*
+	 *  Dziennik zmian - nagłówek ('RPGJ', wersja, numer zapisu) i rekordy [operacja, długość, dane].
+	 *  Rekordy ustawiają wartości (klucz, pole obiektu lub element tablicy), nie różnice.
+	 *  Dziennik dotyczy wyłącznie pełnego zapisu o numerze z nagłówka - odtworzony na innym
+	 *  (np. nowszym, gdy gra padła między podmianą zapisu a usunięciem dziennika) cofnąłby
+	 *  jego zmiany, dlatego przed odtworzeniem numery muszą się zgadzać. Dziennik w wersji 1
+	 *  nie ma numeru i odpowiada zapisowi bez bloku 'GENR' (numer 0).
+	 */
+	static std::vector<char> journalHeader(std::uint32_t generation);
+	static bool journalGeneration(const std::vector<char>& data, std::uint32_t& generation);
+	static void journalSet(std::vector<char>& out, const std::string& key, const nlohmann::json& value);
+	static void journalSetMember(std::vector<char>& out, const std::string& key, const std::string& member, const nlohmann::json& value);
+	static void journalSetIndex(std::vector<char>& out, const std::string& key, std::uint16_t index, const nlohmann::json& value);
+	static void journalDiff(std::vector<char>& out, const std::string& key, const nlohmann::json& before, const nlohmann::json& after);
+	static unsigned replayJournal(const std::vector<char>& data, nlohmann::json& document, std::size_t& consumed);
+
+	/*
+	 *  Zapisuje czytelną wersję zapisu, do debugowania
+	 */
+	static bool exportJson(const nlohmann::json& document, const std::string& path);
+};
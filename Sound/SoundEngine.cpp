@@ -1,23 +1,87 @@
+#include <algorithm>
+#include <iostream>
 #include "SoundEngine.hpp"
+#include "AssetManager.hpp"
+#include "Profiler.hpp"
 
 static double s_master_volume {1.0};
 SoundEngine* SoundEngine::instance = nullptr;
 
-bool SoundEngine::playSound(const std::string &name) {
+//  Dźwięki interfejsu, potrzebne niezależnie od mapy
+static const std::vector<std::string> s_common_sfx {
+	"coins"
+};
+
+SoundEngine::SoundEngine() {
+	instance = this;
+	loader = std::thread(&SoundEngine::loaderThread, this);
+	preload(s_common_sfx);
+}
+
+SoundEngine::~SoundEngine() {
+	{
+		std::lock_guard<std::mutex> lock(loaderMutex);
+		loaderStopping = true;
+	}
+	loaderWake.notify_one();
+	if(loader.joinable())
+		loader.join();
+
+	for(auto& voice : voices)
+		voice.sound.stop();
+	if(currentBGM.music) currentBGM.music->stop();
+	if(fadingBGM.music) fadingBGM.music->stop();
+}
+
+bool SoundEngine::playSound(const std::string &name, SoundPriority priority) {
 	if(!isBuffered(name)) {
+		//  Dźwięk mógł właśnie skończyć się dekodować w tle
+		collectLoads();
+	}
+	if(!isBuffered(name)) {
+		if(evicted.count(name))
+			std::cerr << "Sound '" << name << "' was evicted by the memory budget, loading synchronously\n";
+		else
+			std::cerr << "Sound '" << name << "' was not preloaded, loading synchronously. Add it to the map's soundEffects\n";
 		if(!loadBuffer(name)) {
 			std::cerr << "Could not load buffer for sound '" << name << "', not playing\n";
 			return false;
 		}
 	}
 
-	sounds.emplace_back(sf::Sound{buffers[name]});
-	sounds.back().setVolume(s_master_volume*100.0);
-	sounds.back().play();
+	Voice* voice = acquireVoice(priority);
+	if(!voice) return false;
+
+	voice->sound.setBuffer(buffers[name]);
+	voice->sound.setVolume(s_master_volume*100.0);
+	voice->priority = priority;
+	voice->startedAt = ++voiceClock;
+	voice->sound.play();
+	bufferLastUse[name] = voiceClock;
 
 	return true;
 }
 
+/*
+ *  Zwraca wolny głos, lub wywłaszcza najstarszy głos o najniższym priorytecie
+ *  Jeśli wszystkie głosy mają wyższy priorytet niż żądany, dźwięk jest pomijany.
+ */
+SoundEngine::Voice* SoundEngine::acquireVoice(SoundPriority priority) {
+	Voice* victim = nullptr;
+	for(auto& voice : voices) {
+		if(voice.sound.getStatus() == sf::Sound::Stopped)
+			return &voice;
+
+		if(voice.priority > priority) continue;
+		if(!victim || voice.priority < victim->priority ||
+		   (voice.priority == victim->priority && voice.startedAt < victim->startedAt))
+			victim = &voice;
+	}
+
+	if(victim) victim->sound.stop();
+	return victim;
+}
+
 bool SoundEngine::isBuffered(const std::string &name) {
 	auto ret = buffers.find(name);
 	return ret != buffers.end();
@@ -25,41 +89,278 @@ bool SoundEngine::isBuffered(const std::string &name) {
 
 bool SoundEngine::loadBuffer(const std::string &name) {
 	sf::SoundBuffer buf;
-	if(!buf.loadFromFile("GameContent/SFX/"+name+".wav")) {
+	const std::string path = "GameContent/SFX/"+name+".wav";
+	auto packed = AssetManager::findContent(path);
+	if(packed ? !buf.loadFromMemory(packed.data, packed.size) : !buf.loadFromFile(path)) {
 		return false;
 	}
 	buffers[name] = buf;
+	evicted.erase(name);
+	std::lock_guard<std::mutex> lock(loaderMutex);
+	requested.insert(name);
 	return true;
 }
 
-void SoundEngine::update() {
-	auto it = sounds.begin();
-	while(it != sounds.end()) {
-		if(it->getStatus() == sf::Sound::Stopped) {
-			auto del = it;
-			++it;
-			sounds.erase(del);
+MemoryUsage SoundEngine::bufferMemory() const {
+	MemoryUsage usage;
+	for(const auto& entry : buffers) {
+		usage.cpu += entry.second.getSampleCount() * sizeof(sf::Int16);
+		++usage.count;
+	}
+	return usage;
+}
+
+/*
+ *  Zwalnia najdawniej używane bufory, aż ich łączny rozmiar zmieści się w limicie
+ *  Bufory grające w którymś z głosów są pomijane. Zwolniony dźwięk można ponownie załadować
+ *  przez preload(), lub zostanie wczytany synchronicznie przy następnym odtworzeniu.
+ */
+std::size_t SoundEngine::evictBuffers(std::size_t budget) {
+	std::size_t used = bufferMemory().cpu;
+	std::size_t freed = 0;
+
+	while(used > budget) {
+		auto victim = buffers.end();
+		unsigned long long victimUse = 0;
+		for(auto it = buffers.begin(); it != buffers.end(); ++it) {
+			const bool playing = std::any_of(voices.begin(), voices.end(), [&it](const Voice& voice) {
+				return voice.sound.getBuffer() == &it->second && voice.sound.getStatus() != sf::Sound::Stopped;
+			});
+			if(playing) continue;
+
+			const auto lastUse = bufferLastUse[it->first];
+			if(victim == buffers.end() || lastUse < victimUse) {
+				victim = it;
+				victimUse = lastUse;
+			}
+		}
+		if(victim == buffers.end()) break;
+
+		const auto size = victim->second.getSampleCount() * sizeof(sf::Int16);
+		used -= size;
+		freed += size;
+		{
+			std::lock_guard<std::mutex> lock(loaderMutex);
+			requested.erase(victim->first);
+		}
+		evicted.insert(victim->first);
+		bufferLastUse.erase(victim->first);
+		buffers.erase(victim);
+	}
+
+	return freed;
+}
+
+/*
+ *  Zleca załadowanie w tle dźwięków z manifestu (np. przy wejściu na mapę)
+ */
+void SoundEngine::preload(const std::vector<std::string> &manifest) {
+	bool queued = false;
+	{
+		std::lock_guard<std::mutex> lock(loaderMutex);
+		for(auto& name : manifest) {
+			if(!requested.insert(name).second) continue;
+			pendingLoads.push_back(name);
+			queued = true;
+		}
+	}
+	if(queued) loaderWake.notify_one();
+}
+
+SoundEngine::DecodedSound SoundEngine::decode(const std::string &name) {
+	PROFILE_SCOPE("Decode sound");
+	DecodedSound decoded;
+	decoded.name = name;
+
+	sf::InputSoundFile file;
+	const std::string path = "GameContent/SFX/"+name+".wav";
+	auto packed = AssetManager::findContent(path);
+	if(packed ? !file.openFromMemory(packed.data, packed.size) : !file.openFromFile(path))
+		return decoded;
+
+	decoded.samples.resize(file.getSampleCount());
+	decoded.channels = file.getChannelCount();
+	decoded.sampleRate = file.getSampleRate();
+	decoded.valid = file.read(decoded.samples.data(), decoded.samples.size()) == decoded.samples.size();
+	return decoded;
+}
+
+void SoundEngine::loaderThread() {
+	PROFILE_THREAD("Sound loader");
+	while(true) {
+		std::unique_lock<std::mutex> lock(loaderMutex);
+		loaderWake.wait(lock, [this]() { return loaderStopping || musicRequestPending || !pendingLoads.empty(); });
+		if(loaderStopping) return;
+
+		//  Muzyka ma pierwszeństwo - na nią czeka przejście między mapami
+		if(musicRequestPending) {
+			MusicTrack track;
+			track.name = requestedBGM;
+			const bool looping = requestedLooping;
+			const unsigned generation = musicGeneration;
+			musicRequestPending = false;
+			lock.unlock();
+
+			PROFILE_SCOPE("Open music");
+			//  Z paczki muzyka strumieniowana jest wprost ze zmapowanej pamięci
+			const std::string path = "GameContent/BGM/"+track.name+".ogg";
+			auto packed = AssetManager::findContent(path);
+			track.music = std::make_unique<sf::Music>();
+			if(packed ? !track.music->openFromMemory(packed.data, packed.size) : !track.music->openFromFile(path))
+				track.music.reset();
+			else
+				track.music->setLoop(looping);
+
+			lock.lock();
+			openedBGM = std::move(track);
+			openedGeneration = generation;
+			musicOpenFinished = true;
+			continue;
+		}
+
+		std::string name = std::move(pendingLoads.front());
+		pendingLoads.pop_front();
+		lock.unlock();
+
+		auto decoded = decode(name);
+
+		lock.lock();
+		finishedLoads.push_back(std::move(decoded));
+	}
+}
+
+/*
+ *  Przenosi zdekodowane w tle dźwięki do buforów OpenAL
+ */
+void SoundEngine::collectLoads() {
+	std::vector<DecodedSound> finished;
+	{
+		std::lock_guard<std::mutex> lock(loaderMutex);
+		if(finishedLoads.empty()) return;
+		finished.swap(finishedLoads);
+	}
+
+	for(auto& decoded : finished) {
+		if(isBuffered(decoded.name)) continue;
+		if(!decoded.valid || !buffers[decoded.name].loadFromSamples(decoded.samples.data(), decoded.samples.size(),
+		                                                            decoded.channels, decoded.sampleRate)) {
+			std::cerr << "Could not preload sound '" << decoded.name << "'\n";
+			buffers.erase(decoded.name);
 			continue;
 		}
-		++it;
+		evicted.erase(decoded.name);
 	}
 }
 
+void SoundEngine::update() {
+	PROFILE_SCOPE("Sound");
+	collectLoads();
+	collectMusic();
+	if(crossfading) updateCrossfade();
+}
+
+/*
+ *  Zleca otwarcie utworu w tle. Jeśli żądany utwór już gra (lub jest właśnie otwierany),
+ *  nic nie jest restartowane. Pusta nazwa wycisza aktualną muzykę.
+ */
 void SoundEngine::playMusic(const std::string &name, bool looping) {
-	if(currentBGM.getStatus() == sf::SoundSource::Playing)
-		currentBGM.stop();
+	std::unique_lock<std::mutex> lock(loaderMutex);
+	if(name == requestedBGM) {
+		if(currentBGM.music && currentBGM.name == name)
+			currentBGM.music->setLoop(looping);
+		requestedLooping = looping;
+		return;
+	}
+
+	requestedBGM = name;
+	requestedLooping = looping;
+	++musicGeneration;
+
+	//  Powrót do utworu, który wciąż gra - wystarczy porzucić oczekujące żądanie
+	if(name.empty() || (currentBGM.music && currentBGM.name == name)) {
+		musicRequestPending = false;
+		lock.unlock();
+
+		if(name.empty() && currentBGM.music) {
+			if(fadingBGM.music) fadingBGM.music->stop();
+			fadingBGM = std::move(currentBGM);
+			currentBGM = MusicTrack{};
+			crossfading = true;
+			crossfadeClock.restart();
+		}
+		return;
+	}
+
+	musicRequestPending = true;
+	lock.unlock();
+	loaderWake.notify_one();
+}
+
+/*
+ *  Odbiera utwór otwarty w tle i rozpoczyna przenikanie
+ */
+void SoundEngine::collectMusic() {
+	MusicTrack opened;
+	{
+		std::lock_guard<std::mutex> lock(loaderMutex);
+		if(!musicOpenFinished) return;
+		musicOpenFinished = false;
+		if(openedGeneration != musicGeneration) {
+			openedBGM = MusicTrack{};
+			return;
+		}
+		opened = std::move(openedBGM);
+	}
+
+	if(!opened.music) {
+		std::cerr << "Could not open music '" << opened.name << "'\n";
+		//  Żądanym utworem znów jest ten, który gra - inaczej ponowne playMusic uznałoby nieudany za otwarty
+		std::lock_guard<std::mutex> lock(loaderMutex);
+		if(requestedBGM == opened.name)
+			requestedBGM = currentBGM.name;
+		return;
+	}
+
+	//  Trzeci utwór w trakcie przenikania - najstarszy jest ucinany
+	if(fadingBGM.music) fadingBGM.music->stop();
+	fadingBGM = std::move(currentBGM);
+	currentBGM = std::move(opened);
+
+	currentBGM.music->setVolume(0.0f);
+	currentBGM.music->play();
+	crossfading = true;
+	crossfadeClock.restart();
+	updateCrossfade();
+}
+
+void SoundEngine::updateCrossfade() {
+	float progress = 1.0f;
+	if(crossfadeTime > sf::Time::Zero)
+		progress = std::min(1.0f, crossfadeClock.getElapsedTime() / crossfadeTime);
+
+	if(currentBGM.music)
+		currentBGM.music->setVolume(s_master_volume * 100.0 * progress);
+	if(fadingBGM.music)
+		fadingBGM.music->setVolume(s_master_volume * 100.0 * (1.0f - progress));
+
+	if(progress >= 1.0f) {
+		if(fadingBGM.music) fadingBGM.music->stop();
+		fadingBGM = MusicTrack{};
+		crossfading = false;
+	}
+}
 
-	currentBGM.openFromFile("GameContent/BGM/"+name+".ogg");
-	currentBGM.setLoop(looping);
-	currentBGM.setVolume(s_master_volume * 100.0);
-	currentBGM.play();
+void SoundEngine::setCrossfadeTime(float seconds) {
+	crossfadeTime = sf::seconds(std::max(0.0f, seconds));
 }
 
 void SoundEngine::setVolume(double volume) {
 	s_master_volume = volume;
-	for(auto& sound : instance->sounds) {
-		sound.setVolume(s_master_volume * 100.0);
+	for(auto& voice : instance->voices) {
+		voice.sound.setVolume(s_master_volume * 100.0);
 	}
-	if(instance->currentBGM.getStatus() == sf::Music::Playing)
-		instance->currentBGM.setVolume(s_master_volume * 100.0);
+	if(instance->crossfading)
+		instance->updateCrossfade();
+	else if(instance->currentBGM.music)
+		instance->currentBGM.music->setVolume(s_master_volume * 100.0);
 }
@@ -1,27 +1,109 @@
 #pragma once
 #include <SFML/Audio.hpp>
 #include <unordered_map>
-#include <list>
+#include <unordered_set>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <array>
+#include <memory>
 #include "Types.hpp"
+#include "MemoryBudget.hpp"
+
+enum class SoundPriority : unsigned {
+	Ambient = 0,
+	Normal,
+	Interface,
+	Critical
+};
 
 class SoundEngine {
 	static SoundEngine* instance;
 
+	/*
+	 *  Stała pula głosów - nowy dźwięk zajmuje wolny głos, a gdy takiego brak
+	 *  wywłaszcza najstarszy głos o priorytecie nie wyższym niż własny.
+	 */
+	static const unsigned voiceCount = 16;
+	struct Voice {
+		sf::Sound sound;
+		SoundPriority priority {SoundPriority::Ambient};
+		unsigned long long startedAt {0};
+	};
+	std::array<Voice, voiceCount> voices;
+	unsigned long long voiceClock {0};
+
+	//  Bufory zwalniane są tylko po przekroczeniu limitu pamięci (evictBuffers), i nigdy te,
+	//  które gra właśnie któryś głos
 	std::unordered_map<std::string, sf::SoundBuffer> buffers;
-	std::list<sf::Sound> sounds;
+	std::unordered_map<std::string, unsigned long long> bufferLastUse;
+	std::unordered_set<std::string> evicted;
+
+	//  Dekodowanie plików WAV w tle - wątek roboczy zwraca same próbki,
+	//  a bufory OpenAL tworzone są w update() na głównym wątku
+	struct DecodedSound {
+		std::string name;
+		std::vector<sf::Int16> samples;
+		unsigned channels {0};
+		unsigned sampleRate {0};
+		bool valid {false};
+	};
+	std::thread loader;
+	std::mutex loaderMutex;
+	std::condition_variable loaderWake;
+	std::deque<std::string> pendingLoads;
+	std::vector<DecodedSound> finishedLoads;
+	bool loaderStopping {false};
+	std::unordered_set<std::string> requested;
 
-	sf::Music currentBGM;
+	/*
+	 *  Muzyka otwierana jest na wątku ładującym, a po otwarciu płynnie przenikana
+	 *  z aktualnie grającym utworem. Liczy się tylko ostatnie żądanie - starsze, jeszcze
+	 *  nieotwarte utwory są porzucane.
+	 */
+	struct MusicTrack {
+		std::unique_ptr<sf::Music> music;
+		std::string name;
+	};
+	MusicTrack currentBGM;
+	MusicTrack fadingBGM;
+	std::string requestedBGM;
+	bool requestedLooping {true};
+	bool musicRequestPending {false};
+	MusicTrack openedBGM;
+	bool musicOpenFinished {false};
+	unsigned musicGeneration {0};
+	unsigned openedGeneration {0};
+	bool crossfading {false};
+	sf::Clock crossfadeClock;
+	sf::Time crossfadeTime {sf::seconds(1.5f)};
 
 	bool loadBuffer(const std::string& name);
 	bool isBuffered(const std::string& name);
+	Voice* acquireVoice(SoundPriority priority);
+	void collectLoads();
+	void loaderThread();
+	static DecodedSound decode(const std::string& name);
+	void collectMusic();
+	void updateCrossfade();
 public:
 	static SoundEngine& get() { return *instance; }
+	static bool exists() { return instance != nullptr; }
 	static void setVolume(double volume);
 
-	SoundEngine() { instance = this; }
-	bool playSound(const std::string& name);
+	SoundEngine();
+	~SoundEngine();
+
+	bool playSound(const std::string& name, SoundPriority priority = SoundPriority::Normal);
+	void preload(const std::vector<std::string>& manifest);
 	void update();
 	void playMusic(const std::string& name, bool looping);
+	void setCrossfadeTime(float seconds);
+
+	MemoryUsage bufferMemory() const;
+	std::size_t evictBuffers(std::size_t budget);
 
 	friend class Script;
-};
\ No newline at end of file
+};
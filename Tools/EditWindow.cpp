@@ -5,6 +5,17 @@
 
 void EditWindow::start() {
 	AssetManager::loadMaps();
+	HotReload::start();
+
+	//  Otwarta mapa przeładowana z dysku - narzędzia trzymają wskaźniki na jej NPC, więc są tworzone od nowa
+	auto reloadListener = HotReload::subscribe([this](const AssetChange& change) {
+		if(!EditingMap.isLoaded) return;
+		const auto& maps = AssetManager::getAllMaps();
+		auto map = maps.find(change.name);
+		if((change.kind == AssetKind::Map && map != maps.end() && map->second == EditingMap.mapData) ||
+		   (change.kind == AssetKind::Tileset && change.name == EditingMap.mapData->tilesetName))
+			this->doMapLoadTasks();
+	});
 	width = 1280;
 	height = 720;
 	sf::VideoMode mode;
@@ -17,6 +28,7 @@ void EditWindow::start() {
 
 	sf::Clock deltaClock;
 	while(editorWindow->isOpen()) {
+		HotReload::poll();
 		eventPoll();
 		ImGui::SFML::Update(*editorWindow, deltaClock.restart());
 		editorWindow->clear();
@@ -32,6 +44,7 @@ void EditWindow::start() {
 
 	}
 
+	HotReload::unsubscribe(reloadListener);
 	ImGui::SFML::Shutdown();
 }
 
@@ -239,18 +252,19 @@ void EditWindow::drawMapOpenDialog() {
 		ImGui::InputInt("Height", &height);
 		ImGui::InputInt("Default Tile", &type);
 		if(ImGui::BeginCombo("Spritesheet", selectedSpritesheet.c_str())) {
-			for(const auto& key : AssetManager::getAllTilesets() ) {
-				std::string name = key.first + " (" + std::to_string(key.second.getSpriteSize().x)
-				                   + "x" + std::to_string(key.second.getSpriteSize().y) + ")";
+			for(const auto& tilesetName : AssetManager::getTilesetNames()) {
+				const Spritesheet& tileset = AssetManager::getTileset(tilesetName);
+				std::string name = tilesetName + " (" + std::to_string(tileset.getSpriteSize().x)
+				                   + "x" + std::to_string(tileset.getSpriteSize().y) + ")";
 				if(ImGui::Selectable(name.c_str())) {
-					selectedSpritesheet = key.first;
+					selectedSpritesheet = tilesetName;
 					if(!selectedSpritesheet.empty()) {
 						picker.init(selectedSpritesheet);
 						EditingMap.isTileChosen = true;
 					}
 				}
 
-				if(key.first == selectedSpritesheet)
+				if(tilesetName == selectedSpritesheet)
 					ImGui::SetItemDefaultFocus();
 			}
 			ImGui::EndCombo();
@@ -260,7 +274,7 @@ void EditWindow::drawMapOpenDialog() {
 		ImGui::Dummy(ImVec2(ImGui::GetWindowWidth()-30, 0));
 		if(ImGui::Button("Create") && width > 0 && height > 0) {
 			EditingMap.fname = std::string(buf);
-			EditingMap.mapData = std::make_shared<Map>(std::move(Map::make_empty(Vec2u(width, height), type, selectedSpritesheet)));
+			EditingMap.mapData = Map::make_empty(Vec2u(width, height), type, selectedSpritesheet);
 			EditingMap.mapData->initializeVertexArrays();
 			this->doMapLoadTasks();
 			ImGui::CloseCurrentPopup();
@@ -72,17 +72,11 @@ public:
 		selectedNPC = nullptr;
 		pickingLocation = false;
 
-		for(const auto& ch : AssetManager::getAllCharacters()) {
+		for(const auto& name : AssetManager::getCharacterNames()) {
 			sortedSpritesheets.emplace_back(
-					std::tuple<std::string, Vec2f>(ch.first, ch.second.getSpriteSize())
+					std::tuple<std::string, Vec2f>(name, AssetManager::getCharacter(name).getSpriteSize())
 					);
 		}
-		std::sort(sortedSpritesheets.begin(), sortedSpritesheets.end(),
-		[](const std::tuple<std::string, Vec2f>& a, const std::tuple<std::string, Vec2f>& b) -> bool {
-			return std::lexicographical_compare(std::get<0>(a).begin(), std::get<0>(a).end(),
-			                                    std::get<0>(b).begin(), std::get<0>(b).end()
-					);
-		});
 	}
 
 	void drawToolWindow(Vec2u hoverCoords, sf::RenderTarget &target) override {
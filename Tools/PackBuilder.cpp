@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <SFML/Graphics/Image.hpp>
+#include "AssetPack.hpp"
+
+/*
+ *      RPGPack - buduje paczkę zasobów (GameContent.pack) z katalogu GameContent
+ *  Użycie: RPGPack [katalog źródłowy] [plik wyjściowy]
+ *  Obrazy PNG zapisywane są w paczce jako zdekodowane piksele RGBA, pozostałe pliki bez zmian.
+ *  Zapis gry nie trafia do paczki - należy do gracza, nie do zasobów.
+ */
+
+namespace fs = std::filesystem;
+
+struct PackInput {
+	std::string name;
+	std::vector<char> data;
+	AssetPack::Kind kind;
+};
+
+static bool isSavegame(const std::string& name) {
+	return name.compare(0, 9, "Savegame.") == 0;
+}
+
+static bool readInput(const fs::path& path, const std::string& name, PackInput& input) {
+	input.name = name;
+	input.kind = AssetPack::Kind::Blob;
+
+	if(path.extension() == ".png") {
+		sf::Image image;
+		if(!image.loadFromFile(path.string())) return false;
+
+		const std::uint32_t size[2] = {image.getSize().x, image.getSize().y};
+		const std::size_t pixels = (std::size_t)size[0] * size[1] * 4;
+		input.data.resize(sizeof(size) + pixels);
+		std::memcpy(input.data.data(), size, sizeof(size));
+		std::memcpy(input.data.data() + sizeof(size), image.getPixelsPtr(), pixels);
+		input.kind = AssetPack::Kind::Image;
+		return true;
+	}
+
+	std::ifstream file(path, std::ios::binary);
+	if(!file.good()) return false;
+	input.data.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return true;
+}
+
+static void pad(std::ofstream& out, std::uint64_t& offset) {
+	static const char zeros[8] {};
+	const auto padding = (8 - offset % 8) % 8;
+	out.write(zeros, padding);
+	offset += padding;
+}
+
+int main(int argc, char** argv) {
+	const fs::path source = argc > 1 ? argv[1] : "GameContent";
+	const std::string output = argc > 2 ? argv[2] : AssetPack::defaultPath;
+
+	std::vector<PackInput> inputs;
+	std::error_code ec;
+	for(const auto& entry : fs::recursive_directory_iterator(source, ec)) {
+		if(!entry.is_regular_file()) continue;
+
+		const auto name = fs::relative(entry.path(), source).generic_string();
+		if(isSavegame(name)) continue;
+
+		PackInput input;
+		if(!readInput(entry.path(), name, input)) {
+			std::cerr << "RPGPack: failed reading '" << entry.path().string() << "'\n";
+			return 1;
+		}
+		std::cout << "RPGPack: adding " << name << " (" << input.data.size() << " bytes)\n";
+		inputs.push_back(std::move(input));
+	}
+	if(ec) {
+		std::cerr << "RPGPack: could not scan '" << source.string() << "': " << ec.message() << "\n";
+		return 1;
+	}
+
+	//  Indeks posortowany po hashu - czytnik szuka wpisów wyszukiwaniem binarnym
+	std::sort(inputs.begin(), inputs.end(), [](const PackInput& a, const PackInput& b) {
+		const auto ha = AssetPack::hash(a.name), hb = AssetPack::hash(b.name);
+		return ha != hb ? ha < hb : a.name < b.name;
+	});
+
+	std::vector<AssetPack::Entry> entries(inputs.size());
+	std::string names;
+	for(std::size_t i = 0; i < inputs.size(); ++i) {
+		entries[i].hash = AssetPack::hash(inputs[i].name);
+		entries[i].nameOffset = (std::uint32_t)names.size();
+		entries[i].nameSize = (std::uint32_t)inputs[i].name.size();
+		entries[i].kind = inputs[i].kind;
+		entries[i].reserved = 0;
+		names += inputs[i].name;
+	}
+
+	std::uint64_t offset = sizeof(AssetPack::Header) + entries.size() * sizeof(AssetPack::Entry) + names.size();
+	offset += (8 - offset % 8) % 8;
+	for(std::size_t i = 0; i < inputs.size(); ++i) {
+		entries[i].offset = offset;
+		entries[i].size = inputs[i].data.size();
+		offset += inputs[i].data.size();
+		offset += (8 - offset % 8) % 8;
+	}
+
+	AssetPack::Header header {};
+	std::memcpy(header.magic, AssetPack::magic, sizeof(header.magic));
+	header.version = AssetPack::version;
+	header.entryCount = (std::uint32_t)entries.size();
+	header.namesSize = (std::uint32_t)names.size();
+
+	const std::string tempPath = output + ".tmp";
+	std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+	if(!out.good()) {
+		std::cerr << "RPGPack: could not open '" << tempPath << "' for writing\n";
+		return 1;
+	}
+
+	std::uint64_t written = 0;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(AssetPack::Entry));
+	out.write(names.data(), names.size());
+	written = sizeof(header) + entries.size() * sizeof(AssetPack::Entry) + names.size();
+	pad(out, written);
+	for(const auto& input : inputs) {
+		out.write(input.data.data(), input.data.size());
+		written += input.data.size();
+		pad(out, written);
+	}
+	out.close();
+	if(!out) {
+		std::cerr << "RPGPack: failed writing '" << tempPath << "'\n";
+		return 1;
+	}
+
+	fs::rename(tempPath, output, ec);
+	if(ec) {
+		std::cerr << "RPGPack: could not replace '" << output << "': " << ec.message() << "\n";
+		return 1;
+	}
+
+	std::cout << "RPGPack: wrote " << entries.size() << " entries (" << written << " bytes) to " << output << "\n";
+	return 0;
+}
@@ -43,6 +43,10 @@ public:
 		}
 	}
 
+	Array2D(Array2D&&) = default;
+	Array2D& operator=(const Array2D&) = default;
+	Array2D& operator=(Array2D&&) = default;
+
 	std::vector<T>& operator[](size_t index) {
 		return data[index];
 	}
@@ -3,55 +3,87 @@
 #include "Entity/Script.hpp"
 
 Item::Item(const std::string &itemDesignator)
-: designator(itemDesignator)
-{
-	auto config = AssetManager::getJSON("ItemList")[itemDesignator];
+: Item(ItemRegistry::getID(itemDesignator))
+{ }
 
-	unsigned rare = 0;
-	config["rarity"].get_to<unsigned>(rare);
+Item::Item(const std::string &itemDesignator, unsigned count)
+: Item(ItemRegistry::getID(itemDesignator), count)
+{ }
 
-	unsigned itType = 0;
-	config["type"].get_to<unsigned>(itType);
+Item::Item(ItemID itemID, unsigned count)
+: id(itemID) {
+	assert(itemID < ItemRegistry::count());
+	this->stackCount = std::min(getMaxStack(), count);
+}
 
-	unsigned val = 0;
-	config["value"].get_to<unsigned>(val);
+/*
+ *  Skrypt przedmiotu ładowany jest dopiero przy pierwszym użyciu, raz na definicję,
+ *  i współdzielony przez wszystkie instancje. Dane konkretnej instancji (designator, ilość)
+ *  przekazywane są jako argumenty funkcji skryptu.
+ *  Nieudane ładowanie również jest zapamiętywane, żeby nie próbować przy każdym użyciu.
+ */
+static std::unordered_map<ItemID, std::unique_ptr<Script>> s_item_scripts;
 
-	unsigned maxSt = 1;
-	config["maxStack"].get_to<unsigned>(maxSt);
+Script* Item::getScript(ItemID itemID) {
+	auto& scripts = s_item_scripts;
 
-	std::string scriptName { };
-	//config["script"].get_to<std::string>(scriptName);
+	auto it = scripts.find(itemID);
+	if(it != scripts.end())
+		return it->second.get();
 
-	if(!scriptName.empty()) {
+	const auto& def = ItemRegistry::getDefinition(itemID);
+	std::unique_ptr<Script> script;
+	if(!def.scriptName.empty()) {
 		try {
-			itemScript = std::make_shared<Script>(scriptName);
+			script = std::make_unique<Script>(def.scriptName);
 		} catch (std::exception& ex) {
-			itemScript = nullptr;
+			std::cerr << "Failed loading script '" << def.scriptName << "' for item '" << def.designator << "'\n";
+			std::cerr << "Details: " << ex.what() << "\n";
 		}
 	}
 
-	this->rarity = (Rarity)rare;
-	this->type = (ItemType)itType;
-	this->value = val;
-	this->maxStack = maxSt;
-	this->stackCount = 1;
-	config["itemSprite"].get_to<unsigned>(this->itemSpriteIndex);
-}
-
-Item::Item(const std::string &itemDesignator, unsigned count)
-: Item(itemDesignator)
-{
-	this->stackCount = std::min(this->maxStack, count);
+	return scripts.emplace(itemID, std::move(script)).first->second.get();
+}
+
+/*
+ *  Po zmianie ItemList.json lub plików skryptów - zapomina skrypty, które nie pasują już do definicji
+ *  przedmiotu, oraz zapamiętane nieudane ładowania. Zostaną wczytane ponownie przy następnym użyciu.
+ *  Skrypty czekające na dialog zostają, bo dialog trzyma do nich wskaźnik.
+ */
+void Item::refreshScripts() {
+	for(auto it = s_item_scripts.begin(); it != s_item_scripts.end(); ) {
+		const auto& script = it->second;
+		const bool stale = it->first >= ItemRegistry::count() || !script ||
+		                   script->getName() != ItemRegistry::getDefinition(it->first).scriptName;
+		if(stale && !(script && script->isYielding()))
+			it = s_item_scripts.erase(it);
+		else
+			++it;
+	}
 }
 
 void Item::onUse() {
-	if(itemScript)
-		itemScript->executeFunction("onUse");
+	auto script = getScript(id);
+	if(!script || !script->hasFunction("onUse")) return;
+
+	try {
+		script->executeFunction("onUse", getDesignator(), stackCount);
+	} catch (std::exception& ex) {
+		std::cerr << "Item::onUse()/ Script '" << script->getName() << "' failed for item '" << getDesignator() << "'\n";
+		std::cerr << "Details: " << ex.what() << "\n";
+	}
 }
 
 void Item::onEquip(bool remove) {
-	if(itemScript)
-		itemScript->executeFunction("onEquip");
+	auto script = getScript(id);
+	if(!script || !script->hasFunction("onEquip")) return;
+
+	try {
+		script->executeFunction("onEquip", getDesignator(), stackCount, remove);
+	} catch (std::exception& ex) {
+		std::cerr << "Item::onEquip()/ Script '" << script->getName() << "' failed for item '" << getDesignator() << "'\n";
+		std::cerr << "Details: " << ex.what() << "\n";
+	}
 }
 
 sf::Color Item::getRarityColor(Rarity rarity) {
@@ -129,13 +161,15 @@ std::string Item::getTypeString(ItemType type) {
 }
 
 void Item::draw(sf::RenderTarget &target, Vec2f pos, sf::Color color) const {
-	auto sprite = AssetManager::getUI("ItemList").getSprite(itemSpriteIndex);
+	static const TextureHandle itemSheet = AssetManager::findUI("ItemList");
+	auto sprite = AssetManager::getSpritesheet(itemSheet).getSprite(getDefinition().itemSprite);
 	sprite.setPosition(pos);
 	sprite.setColor(color);
 	target.draw(sprite);
 }
 
 unsigned Item::addStack(unsigned count) {
+	const unsigned maxStack = getMaxStack();
 	int overflow = (int)(stackCount + count) - maxStack;
 	if(overflow > 0) {
 		stackCount = maxStack;
@@ -146,55 +180,16 @@ unsigned Item::addStack(unsigned count) {
 	}
 }
 
-std::string Item::getName() const {
-	const auto& list = AssetManager::getJSON("ItemList");
-	if(!list.contains(designator) || (!list[designator].contains("name")))
-		return "undefined";
-
-	return list[designator]["name"];
-}
-
-std::string Item::getDescription() const {
-	const auto& list = AssetManager::getJSON("ItemList");
-	if(!list.contains(designator) || (!list[designator].contains("description")))
-		return "undefined";
-
-	return list[designator]["description"];
-}
-
-int Item::getStat(std::string statistic) const {
-	const auto& list = AssetManager::getJSON("ItemList");
-	if (!list.contains(designator) || !list[designator].contains("stats") || !list[designator]["stats"].contains(statistic) )
+int Item::getStat(const std::string& statistic) const {
+	auto stat = ItemRegistry::statFromName(statistic);
+	if(stat == ItemStat::_DummyEnd)
 		return 0;
 
-	return list[designator]["stats"][statistic];
-}
-
-std::string Item::getStats() const {
-	const auto& list = AssetManager::getJSON("ItemList");
-	if(!list.contains(designator) || (!list[designator].contains("stats")))
-		return "undefined";
-
-	std::string text;
-	const auto& stats = list[designator]["stats"];
-
-	for(auto it = stats.begin(); it != stats.end(); ++it) {
-		const auto val = it->get<int>();
-		if(val > 0) text += '+';
-		text += std::to_string(val) + " ";
-		text += it.key();
-		if(it != --stats.end()) text += '\n';
-	}
-
-	return text;
+	return getStat(stat);
 }
 
 bool operator==(const Item& a, const Item& b) {
-	return a.getDesignator() == b.getDesignator() &&
-		   a.getRarity() == b.getRarity() &&
-	       a.getType() == b.getType() &&
-	       a.getValue() == b.getValue() &&
-	       a.getMaxStack() == b.getMaxStack();
+	return a.getID() == b.getID();
 }
 
 std::ostream &operator<<(std::ostream &os, const Item &item) {
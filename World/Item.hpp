@@ -1,76 +1,71 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <memory>
-
-enum class Rarity : unsigned {
-	Common    = 0,
-	Uncommon  = 1,
-	Rare      = 2,
-	Legendary = 3,
-	Epic      = 4
-};
-
-
-enum class ItemType : unsigned {
-	Generic = 0,
-	QuestItem = 1,
-	Consumable = 2,
-
-	ArmorHelmet = 30,
-	ArmorChest  = 31,
-	ArmorPants  = 32,
-	ArmorBoots  = 33,
-
-	EquipRing      = 50,
-	EquipNecklace  = 51,
-	EquipGloves    = 52,
-	EquipBraces    = 53,
-
-	WeaponSword    = 70,
-	WeaponBow      = 71,
-	WeaponStaff    = 72,
-	Shield		   = 73,
-};
+#include "Types.hpp"
+#include "World/ItemRegistry.hpp"
 
 class Script;
 
 class Item {
-	std::string designator;
-	std::shared_ptr<Script> itemScript;
-	Rarity rarity;
-	ItemType type;
-	unsigned value;
+	ItemID id;
 	unsigned stackCount;
-	unsigned maxStack;
-	unsigned itemSpriteIndex;
 public:
 	Item(const std::string& itemDesignator);
 	Item(const std::string& itemDesignator, unsigned count);
+	Item(ItemID itemID, unsigned count = 1);
+
+	const ItemDef& getDefinition() const { return ItemRegistry::getDefinition(id); }
+	ItemID getID() const { return id; }
 
-	unsigned getValue() const { return value; }
+	unsigned getValue() const { return getDefinition().value; }
 	unsigned getStack() const { return stackCount; }
-	unsigned getMaxStack() const { return maxStack; }
-	Rarity getRarity() const { return rarity; }
-	ItemType getType() const { return type; }
-	const std::string& getDesignator() const { return designator; }
+	unsigned getMaxStack() const { return getDefinition().maxStack; }
+	Rarity getRarity() const { return getDefinition().rarity; }
+	ItemType getType() const { return getDefinition().type; }
+	const std::string& getDesignator() const { return getDefinition().designator; }
 
 	void onUse();
 	void onEquip(bool remove = false);
 	unsigned addStack(unsigned count);
 
-	std::string getName() const;
-	std::string getDescription() const;
-	std::string getStats() const;
-	int getStat(std::string) const;
+	const std::string& getName() const { return getDefinition().name; }
+	const std::string& getDescription() const { return getDefinition().description; }
+	const std::string& getStats() const { return getDefinition().statsText; }
+	int getStat(ItemStat statistic) const { return getDefinition().stats[(unsigned)statistic]; }
+	int getStat(const std::string&) const;
 
 	void draw(sf::RenderTarget& target, Vec2f pos, sf::Color color = sf::Color::White) const;
 
+	static Script* getScript(ItemID);
+	static void refreshScripts();
 	static sf::Color getRarityColor(Rarity);
 	static std::string getRarityString(Rarity);
 	static std::string getTypeString(ItemType);
 };
 
+/*
+ *      ItemSlot - miejsce w plecaku lub ekwipunku, przechowywane przez wartość
+ *  Zawiera jedynie indeks definicji, ilość oraz flagi danej instancji (przekazywane np. do skryptów
+ *  przedmiotów). Pusty slot ma count równe 0, więc cały plecak to płaska tablica bez alokacji.
+ */
+struct ItemSlot {
+	ItemID id {ItemRegistry::invalidID};
+	std::uint16_t count {0};
+	std::uint16_t flags {0};
+
+	ItemSlot() = default;
+	ItemSlot(const Item& item)
+	: id(item.getID()), count((std::uint16_t)item.getStack()) { }
+
+	bool empty() const { return count == 0; }
+	void clear() { *this = ItemSlot{}; }
+
+	const ItemDef& getDefinition() const { return ItemRegistry::getDefinition(id); }
+	int getStat(ItemStat statistic) const { return getDefinition().stats[(unsigned)statistic]; }
+	Item toItem() const { return Item{id, count}; }
+};
+
 bool operator==(const Item&, const Item&);
 std::ostream& operator<<(std::ostream& os, const Item& item);
 std::ostream& operator<<(std::ostream& os, const Rarity& item);
-std::ostream& operator<<(std::ostream& os, const ItemType& item);
\ No newline at end of file
+std::ostream& operator<<(std::ostream& os, const ItemType& item);
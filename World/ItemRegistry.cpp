@@ -0,0 +1,145 @@
+#include <algorithm>
+#include "World/ItemRegistry.hpp"
+
+static const char* s_stat_names[(unsigned)ItemStat::_DummyEnd] = {
+	"HP",
+	"MaxHP",
+	"MP",
+	"MaxMP",
+	"Attack",
+	"Fire",
+	"Water",
+	"Lightning",
+	"AttackSpeed",
+	"Armor",
+	"Resistance",
+	"Critical",
+	"Dodge"
+};
+
+/*
+ *  Kompiluje pojedynczą definicję przedmiotu
+ *  Brakujące pola dostają wartości domyślne (edytor przedmiotów nie zawsze je zapisuje),
+ *  a nieznane statystyki trafiają jedynie do opisu tekstowego.
+ */
+static bool compileDefinition(const std::string& designator, const nlohmann::json& config, ItemDef& def) {
+	def.designator = designator;
+
+	try {
+		def.name = config.value("name", std::string{"undefined"});
+		def.description = config.value("description", std::string{"undefined"});
+		def.scriptName = config.value("script", std::string{});
+		def.rarity = (Rarity)config.value("rarity", 0u);
+		def.type = (ItemType)config.value("type", 0u);
+		def.value = config.value("value", 0u);
+		def.maxStack = std::clamp(config.value("maxStack", 1u), 1u, (unsigned)std::numeric_limits<std::uint16_t>::max());
+		def.itemSprite = config.value("itemSprite", 0u);
+
+		if(config.contains("stats")) {
+			const auto& stats = config["stats"];
+			for(auto stat = stats.begin(); stat != stats.end(); ++stat) {
+				const auto val = stat->get<int>();
+
+				auto index = ItemRegistry::statFromName(stat.key());
+				if(index != ItemStat::_DummyEnd)
+					def.stats[(unsigned)index] = val;
+
+				if(val > 0) def.statsText += '+';
+				def.statsText += std::to_string(val) + " ";
+				def.statsText += stat.key();
+				if(stat != --stats.end()) def.statsText += '\n';
+			}
+		} else {
+			def.statsText = "undefined";
+		}
+	} catch (std::exception& ex) {
+		std::cerr << "ItemRegistry::compile() failed compiling item '" << designator << "'\n";
+		std::cerr << "Details: " << ex.what() << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ *  Kompiluje zawartość ItemList.json do tablicy definicji
+ */
+void ItemRegistry::compile(const nlohmann::json& itemList) {
+	auto& registry = get();
+	registry.definitions.clear();
+	registry.designators.clear();
+
+	if(!itemList.is_object()) {
+		std::cerr << "ItemRegistry::compile() expected an object of item definitions\n";
+		return;
+	}
+
+	registry.definitions.reserve(itemList.size());
+	for(auto it = itemList.begin(); it != itemList.end(); ++it) {
+		if(registry.definitions.size() == invalidID) {
+			std::cerr << "ItemRegistry::compile() too many item definitions, ignoring '" << it.key() << "' and following\n";
+			break;
+		}
+
+		ItemDef def;
+		if(!compileDefinition(it.key(), it.value(), def))
+			continue;
+
+		registry.designators[def.designator] = (ItemID)registry.definitions.size();
+		registry.definitions.push_back(std::move(def));
+	}
+}
+
+/*
+ *  Ponowna kompilacja po zmianie ItemList.json w trakcie gry
+ *  Istniejące przedmioty zachowują swoje ItemID (gracz może je mieć w ekwipunku), nowe dopisywane są
+ *  na końcu tablicy. Usunięte definicje zostają do ponownego uruchomienia, by żaden ItemID nie wisiał.
+ */
+void ItemRegistry::reload(const nlohmann::json& itemList) {
+	auto& registry = get();
+	if(!itemList.is_object()) {
+		std::cerr << "ItemRegistry::reload() expected an object of item definitions\n";
+		return;
+	}
+
+	unsigned updated = 0, added = 0;
+	for(auto it = itemList.begin(); it != itemList.end(); ++it) {
+		ItemDef def;
+		if(!compileDefinition(it.key(), it.value(), def))
+			continue;
+
+		auto existing = registry.designators.find(def.designator);
+		if(existing != registry.designators.end()) {
+			registry.definitions[existing->second] = std::move(def);
+			++updated;
+			continue;
+		}
+
+		if(registry.definitions.size() == invalidID) {
+			std::cerr << "ItemRegistry::reload() too many item definitions, ignoring '" << it.key() << "'\n";
+			continue;
+		}
+		registry.designators[def.designator] = (ItemID)registry.definitions.size();
+		registry.definitions.push_back(std::move(def));
+		++added;
+	}
+
+	for(const auto& [designator, id] : registry.designators) {
+		if(!itemList.contains(designator))
+			std::cerr << "ItemRegistry::reload()/ Item '" << designator << "' was removed, keeping it until restart\n";
+	}
+	std::cout << "ItemRegistry::reload()/ Updated " << updated << " items, added " << added << "\n";
+}
+
+ItemStat ItemRegistry::statFromName(const std::string& name) {
+	for(unsigned i = 0; i < (unsigned)ItemStat::_DummyEnd; ++i) {
+		if(name == s_stat_names[i])
+			return (ItemStat)i;
+	}
+	return ItemStat::_DummyEnd;
+}
+
+const char* ItemRegistry::statName(ItemStat stat) {
+	if(stat >= ItemStat::_DummyEnd) return "undefined";
+	return s_stat_names[(unsigned)stat];
+}
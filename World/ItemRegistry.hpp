@@ -0,0 +1,136 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <unordered_map>
+#include "Tools/json.hpp"
+
+enum class Rarity : unsigned {
+	Common    = 0,
+	Uncommon  = 1,
+	Rare      = 2,
+	Legendary = 3,
+	Epic      = 4
+};
+
+
+enum class ItemType : unsigned {
+	Generic = 0,
+	QuestItem = 1,
+	Consumable = 2,
+
+	ArmorHelmet = 30,
+	ArmorChest  = 31,
+	ArmorPants  = 32,
+	ArmorBoots  = 33,
+
+	EquipRing      = 50,
+	EquipNecklace  = 51,
+	EquipGloves    = 52,
+	EquipBraces    = 53,
+
+	WeaponSword    = 70,
+	WeaponBow      = 71,
+	WeaponStaff    = 72,
+	Shield		   = 73,
+};
+
+/*
+ *  Statystyki które przedmiot może modyfikować. Kolejność odpowiada kolejności statystyk
+ *  wyświetlanych w UI (InvUI, PlayerUI), dzięki czemu można je indeksować bezpośrednio.
+ */
+enum class ItemStat : unsigned {
+	HP = 0,
+	MaxHP,
+	MP,
+	MaxMP,
+	Attack,
+	Fire,
+	Water,
+	Lightning,
+	AttackSpeed,
+	Armor,
+	Resistance,
+	Critical,
+	Dodge,
+	_DummyEnd
+};
+
+typedef std::uint16_t ItemID;
+
+/*
+ *      ItemDef - skompilowana definicja przedmiotu z ItemList.json
+ *  Wszystkie instancje danego przedmiotu współdzielą jedną definicję, a same przechowują jedynie
+ *  jej indeks (ItemID) oraz ilość w stacku.
+ */
+struct ItemDef {
+	std::string designator;
+	std::string name;
+	std::string description;
+	std::string statsText;
+	std::string scriptName;
+	Rarity rarity {Rarity::Common};
+	ItemType type {ItemType::Generic};
+	unsigned value {0};
+	unsigned maxStack {1};
+	unsigned itemSprite {0};
+	std::array<int, (unsigned)ItemStat::_DummyEnd> stats {};
+};
+
+/*
+ *      ItemRegistry - ciągła tablica definicji przedmiotów
+ *  Budowana raz, podczas ładowania zasobów w AssetManager. Po tym momencie każdy dostęp do danych
+ *  przedmiotu to zwykłe indeksowanie wektora, bez przeszukiwania dokumentu JSON.
+ *  Nazwy (designatory) rozwiązywane są do ItemID tylko w miejscach gdzie przedmioty są tworzone
+ *  (skrypty, zapis gry, sklepy).
+ */
+class ItemRegistry {
+	std::vector<ItemDef> definitions;
+	std::unordered_map<std::string, ItemID> designators;
+
+	static ItemRegistry& get() {
+		static ItemRegistry registry;
+		return registry;
+	}
+public:
+	static constexpr ItemID invalidID = std::numeric_limits<ItemID>::max();
+
+	static void compile(const nlohmann::json& itemList);
+	static void reload(const nlohmann::json& itemList);
+
+	static const ItemDef& getDefinition(ItemID id) {
+		assert(id < get().definitions.size());
+		return get().definitions[id];
+	}
+
+	static ItemID findID(const std::string& designator) {
+		auto it = get().designators.find(designator);
+		if(it == get().designators.end())
+			return invalidID;
+		return it->second;
+	}
+
+	static ItemID getID(const std::string& designator) {
+		auto id = findID(designator);
+		if(id == invalidID) {
+			std::cerr << "Item '" << designator << "' does not exist!\n";
+			throw std::runtime_error("Requested non-existant item '" + designator + "'");
+		}
+		return id;
+	}
+
+	static bool exists(const std::string& designator) {
+		return findID(designator) != invalidID;
+	}
+
+	static std::size_t count() {
+		return get().definitions.size();
+	}
+
+	static ItemStat statFromName(const std::string& name);
+	static const char* statName(ItemStat stat);
+};
@@ -4,20 +4,18 @@
 #include "Map.hpp"
 #include "Tools/json.hpp"
 #include "JsonOverloads.hpp"
+#include "Profiler.hpp"
 
 /*
  *  Ładuje mapę z pliku i zwraca go w obiekcie klasy Map
  *
  *  Narazie mapa jest hardcodowana, ale ewentualnie będziemy tu ładować mapę z pliku.
  */
-Map Map::from_file(const std::string& mapName) {
-	//  Ładowanie z pliku
-	std::ifstream file;
-	file.open("GameContent/Map/"+mapName+".json");
-	if(!file.good())
+std::shared_ptr<Map> Map::from_file(const std::string& mapName) {
+	//  Ładowanie z pliku (lub z paczki zasobów)
+	std::string mapJson;
+	if(!AssetManager::readContent("GameContent/Map/"+mapName+".json", mapJson))
 		throw std::runtime_error("Could not load map '" + mapName + "' from file. Is the map present in your GameContent/Maps folder?");
-	std::string mapJson((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-	file.close();
 
 	//  Parsowanie danych json
 	json js = json::parse(mapJson);
@@ -25,13 +23,13 @@ Map Map::from_file(const std::string& mapName) {
 	std::string tilesetName = js["mapConfig"]["tileset"];
 	if(tilesetName.empty())
 		throw std::runtime_error("Map does not specify Tileset to use");
-	Map newMap {{size.x, size.y}, tilesetName};
+	auto newMap = std::make_shared<Map>(ConstructionKey{}, Vec2u{size.x, size.y}, tilesetName);
 
 	auto npcData = js["mapData"]["npcs"];
 	if(!npcData.is_null()) {
 		auto data = npcData.get<std::vector<NPCData>>();
 		for(auto& v : data) {
-			newMap.npcs.push_back(std::make_shared<NPC>(v.spritesheetName, Vec2u{v.worldPosition.x, v.worldPosition.y}, v.scriptName));
+			newMap->npcs.push_back(std::make_shared<NPC>(v.spritesheetName, Vec2u{v.worldPosition.x, v.worldPosition.y}, v.scriptName));
 		}
 	}
 
@@ -57,16 +55,20 @@ Map Map::from_file(const std::string& mapName) {
 			}
 
 			for(unsigned y = 0; y < size.y; ++y) {
-				newMap.floorTiles[layer][x][y] = tileData[layer][x][y];
+				newMap->floorTiles[layer][x][y] = tileData[layer][x][y];
 			}
 		}
 	}
 
 	if(!js["mapData"]["connections"].is_null())
-		newMap.connections = js["mapData"]["connections"].get<std::vector<Connection>>();
+		newMap->connections = js["mapData"]["connections"].get<std::vector<Connection>>();
 
 	if(!js["mapConfig"]["backgroundMusic"].is_null())
-		newMap.bgMusic = js["mapConfig"]["backgroundMusic"].get<std::string>();
+		newMap->bgMusic = js["mapConfig"]["backgroundMusic"].get<std::string>();
+
+	//  Manifest efektów dźwiękowych używanych na mapie - ładowane w tle przy wejściu na mapę
+	if(!js["mapConfig"]["soundEffects"].is_null())
+		newMap->soundEffects = js["mapConfig"]["soundEffects"].get<std::vector<std::string>>();
 
 	return newMap;
 }
@@ -105,32 +107,108 @@ void Map::serializeToFile(const std::string &filename) {
 
 	j["mapData"]["connections"] = this->connections;
 	j["mapConfig"]["backgroundMusic"] = this->bgMusic;
+	if(!soundEffects.empty())
+		j["mapConfig"]["soundEffects"] = this->soundEffects;
 
 	file << j.dump(1, '\t');
 	file.close();
 }
 
 
-Map::Map(const Map &map)
-: tileset(AssetManager::getTileset(map.tilesetName), map.tilesetName) {
-	this->player = map.player;
-	this->tilesetName = map.tilesetName;
-	this->size = map.size;
-	this->vertices = map.vertices;
-	this->layerVertices = map.layerVertices;
-	this->npcs = map.npcs;
-	this->connections = map.connections;
+/*
+ *  Przeniesienie mapy - sf::VertexBuffer nie ma konstruktora przenoszącego, więc bufory GPU
+ *  są zamieniane zamiast kopiowane
+ */
+Map::Map(Map &&map)
+: standingOnConnection(map.standingOnConnection),
+  tilesetName(std::move(map.tilesetName)),
+  bgMusic(std::move(map.bgMusic)),
+  soundEffects(std::move(map.soundEffects)),
+  size(map.size),
+  tileset(std::move(map.tileset)),
+  floorTiles{std::move(map.floorTiles[0]), std::move(map.floorTiles[1]), std::move(map.floorTiles[2])},
+  npcs(std::move(map.npcs)),
+  player(map.player),
+  vertices(std::move(map.vertices)),
+  layerVertices(std::move(map.layerVertices)),
+  buffersResident(map.buffersResident),
+  connections(std::move(map.connections)) {
+	for(unsigned i = 0; i < 5; i++)
+		this->buffer[i].swap(map.buffer[i]);
+	map.buffersResident = false;
+}
+
+Map& Map::operator=(Map &&map) {
 	this->standingOnConnection = map.standingOnConnection;
-	this->bgMusic = map.bgMusic;
+	this->tilesetName = std::move(map.tilesetName);
+	this->bgMusic = std::move(map.bgMusic);
+	this->soundEffects = std::move(map.soundEffects);
+	this->size = map.size;
+	this->tileset = std::move(map.tileset);
+	this->npcs = std::move(map.npcs);
+	this->player = map.player;
+	this->vertices = std::move(map.vertices);
+	this->layerVertices = std::move(map.layerVertices);
+	this->connections = std::move(map.connections);
 
 	for(unsigned layer = 0; layer < 3; layer++)
-		this->floorTiles[layer] = map.floorTiles[layer];
+		this->floorTiles[layer] = std::move(map.floorTiles[layer]);
 
+	//  Stare bufory trafiają do przenoszonej mapy i są zwalniane razem z nią
 	for(unsigned i = 0; i < 5; i++)
-		this->buffer[i] = map.buffer[i];
+		this->buffer[i].swap(map.buffer[i]);
+	std::swap(this->buffersResident, map.buffersResident);
+
+	return *this;
+}
+
+/*
+ *  Przeładowuje mapę z pliku w miejscu - wszyscy trzymający wskaźnik na mapę widzą nową zawartość,
+ *  a gracz pozostaje do niej przypięty. Jeśli skrypt któregoś NPC czeka właśnie na dialog lub sklep,
+ *  przeładowanie jest odkładane - usunięcie NPC zostawiłoby dialog z nieistniejącym skryptem.
+ */
+ReloadResult Map::reload(const std::string &mapName) {
+	for(auto& npc : npcs) {
+		if(npc->scriptYielding())
+			return ReloadResult::Deferred;
+	}
+
+	try {
+		auto fresh = Map::from_file(mapName);
+
+		const Player* boundPlayer = this->player;
+		*this = std::move(*fresh);
+		this->player = boundPlayer;
+		this->standingOnConnection.valid = false;
+
+		this->initializeVertexArrays();
+	} catch (std::exception& ex) {
+		std::cerr << "Map::reload()/ Failed reloading map '" << mapName << "'\n";
+		std::cerr << "Details: " << ex.what() << "\n";
+		return ReloadResult::Failed;
+	}
+
+	return ReloadResult::Reloaded;
+}
+
+/*
+ *  Ponownie wczytuje konfigurację kafli tilesetu i przebudowuje bufory wierzchołków
+ *  (priorytety kafli i rozmiar tekstury mogły się zmienić)
+ */
+bool Map::reloadTileset() {
+	try {
+		this->tileset = TileSet(AssetManager::getTileset(tilesetName), tilesetName);
+		this->initializeVertexArrays();
+	} catch (std::exception& ex) {
+		std::cerr << "Map::reloadTileset()/ Failed reloading tileset '" << tilesetName << "'\n";
+		std::cerr << "Details: " << ex.what() << "\n";
+		return false;
+	}
+	return true;
 }
 
 void Map::draw(sf::RenderTarget &target) {
+	PROFILE_SCOPE("Map draw");
 	for(unsigned i = 0; i < 5; ++i) {
 		if(i == 1) this->drawEntities(target);
 		target.draw(buffer[i], &tileset.getTexture());
@@ -178,7 +256,9 @@ void Map::initializeVertexArrays() {
 	}
 
 	for(unsigned i = 0; i < 5; i++) {
+		//  Przy przebudowie warstwa mogła zostać opróżniona - stary bufor nie może zostać narysowany
 		if(vertices[i].getVertexCount() == 0) {
+			buffer[i] = sf::VertexBuffer();
 			continue;
 		}
 
@@ -192,6 +272,38 @@ void Map::initializeVertexArrays() {
 		buffer[i].setPrimitiveType(sf::Quads);
 		buffer[i].update(&vertices[i][0], vertices[i].getVertexCount(), 0);
 	}
+	buffersResident = true;
+}
+
+void Map::releaseBuffers() {
+	for(auto& vertice : vertices)
+		vertice = sf::VertexArray();
+
+	for(auto& vertice : layerVertices)
+		vertice = sf::VertexArray();
+
+	for(auto& buf : buffer)
+		buf = sf::VertexBuffer();
+
+	buffersResident = false;
+}
+
+std::size_t Map::gpuMemory() const {
+	std::size_t bytes = 0;
+	for(auto& buf : buffer)
+		bytes += buf.getVertexCount() * sizeof(sf::Vertex);
+	return bytes;
+}
+
+std::size_t Map::cpuMemory() const {
+	std::size_t bytes = 0;
+	for(auto& vertice : vertices)
+		bytes += vertice.getVertexCount() * sizeof(sf::Vertex);
+	for(auto& vertice : layerVertices)
+		bytes += vertice.getVertexCount() * sizeof(sf::Vertex);
+	for(auto& layer : floorTiles)
+		bytes += (std::size_t)layer.getX() * layer.getY() * sizeof(unsigned);
+	return bytes;
 }
 
 
@@ -274,14 +386,13 @@ void Map::drawEntities(sf::RenderTarget &target) {
  *  Tworzy pustą mapę o podanych rozmiarach
  *  Domyślny tileID to 0
  */
-Map Map::make_empty(Vec2u size, unsigned defType, const std::string& tilesetName) {
-	Map newMap {size, tilesetName};
+std::shared_ptr<Map> Map::make_empty(Vec2u size, unsigned defType, const std::string& tilesetName) {
+	auto newMap = std::make_shared<Map>(ConstructionKey{}, size, tilesetName);
 
-	newMap.tilesetName = tilesetName;
 	for(unsigned layer = 0; layer < 3; layer++) {
 		for(unsigned i = 0; i < size.x; i++) {
 			for(unsigned j = 0; j < size.y; j++) {
-				newMap.floorTiles[layer][i][j] = (layer == 0) ? defType : 0;
+				newMap->floorTiles[layer][i][j] = (layer == 0) ? defType : 0;
 			}
 		}
 	}
@@ -289,7 +400,7 @@ Map Map::make_empty(Vec2u size, unsigned defType, const std::string& tilesetName
 	return newMap;
 }
 
-Map::Map(Vec2u _size, const std::string &tilesetz)
+Map::Map(ConstructionKey, Vec2u _size, const std::string &tilesetz)
 : tileset(AssetManager::getTileset(tilesetz), tilesetz){
 	assert(_size.x != 0 && _size.y != 0);
 	this->player = nullptr;
@@ -304,6 +415,7 @@ Map::Map(Vec2u _size, const std::string &tilesetz)
  *  Aktualizuje wszystkie NPC na mapie
  */
 void Map::updateActors() {
+	PROFILE_SCOPE("Actors");
 	for(auto& npc : npcs) {
 		while(npc->wantsToMove()) {
 			moveActor(*npc, npc->popMovement());
@@ -19,6 +19,10 @@ struct Connection {
 };
 
 class Map {
+	//  Klucz konstruktora - mapy tworzone są wyłącznie przez from_file()/make_empty(),
+	//  bezpośrednio w miejscu docelowym (jedna alokacja, bez kopiowania buforów)
+	struct ConstructionKey { explicit ConstructionKey() = default; };
+
 	struct {
 		Connection goingThroughConnection;
 		bool valid = false;
@@ -26,6 +30,7 @@ class Map {
 
 	std::string tilesetName;
 	std::string bgMusic;
+	std::vector<std::string> soundEffects;
 
 	Vec2u size;
 
@@ -40,6 +45,7 @@ class Map {
 	std::array<sf::VertexArray, 3> layerVertices;
 
 	sf::VertexBuffer buffer[5];
+	bool buffersResident {false};
 
 	std::vector<Connection> connections;
 protected:
@@ -47,15 +53,18 @@ protected:
 	void drawTiles(sf::RenderTarget&);
 	void drawTiles(sf::RenderTarget&, unsigned);
 	void drawEntities(sf::RenderTarget&);
-	Map(Vec2u size, const std::string& tileset);
 
 	void serializeToFile(const std::string& file);
 public:
-	Map(const Map&);
+	Map(ConstructionKey, Vec2u size, const std::string& tileset);
+	Map(const Map&) = delete;
+	Map& operator=(const Map&) = delete;
+	Map(Map&&);
+	Map& operator=(Map&&);
 	~Map() = default;
 
-	static Map from_file(const std::string& path);
-	static Map make_empty(Vec2u size, unsigned defType, const std::string& tilesetName="Tileset");
+	static std::shared_ptr<Map> from_file(const std::string& path);
+	static std::shared_ptr<Map> make_empty(Vec2u size, unsigned defType, const std::string& tilesetName="Tileset");
 
 	unsigned& getType(Vec2u pos, unsigned layer) {
 		assert(layer < 3);
@@ -71,11 +80,24 @@ public:
 	void draw(sf::RenderTarget&);
 	void initializeVertexArrays();
 
+	ReloadResult reload(const std::string& mapName);
+	bool reloadTileset();
+
+	/*
+	 *  Zwolnienie wierzchołków i buforów nieużywanej mapy (limit pamięci) - przebudowywane
+	 *  przez initializeVertexArrays() przy kolejnym AssetManager::getMap()
+	 */
+	void releaseBuffers();
+	bool hasBuffers() const { return buffersResident; }
+	std::size_t gpuMemory() const;
+	std::size_t cpuMemory() const;
+
 	void updateActors();
 
 	bool moveActor(Actor &actor, Direction dir);
 
 	NPC* findNPC(Vec2u pos);
+	void addNPC(std::shared_ptr<NPC> npc) { npcs.push_back(std::move(npc)); }
 
 	void bindPlayer(const Player& _player) {
 		player = &_player;
@@ -96,10 +118,18 @@ public:
 		return standingOnConnection.goingThroughConnection;
 	}
 
+	const std::string& getTilesetName() const {
+		return tilesetName;
+	}
+
 	const std::string& music() {
 		return bgMusic;
 	}
 
+	const std::vector<std::string>& sfxManifest() const {
+		return soundEffects;
+	}
+
 	friend class EditWindow;
 	friend class NPCCreator;
 	friend class Brush;
@@ -1,18 +1,55 @@
 #include <algorithm>
 #include "World/WorldManager.hpp"
 #include "Sound/SoundEngine.hpp"
+#include "Profiler.hpp"
 
 static bool s_should_save_game {false};
 static bool s_should_load_game {false};
+static bool s_should_autosave {false};
+
+WorldManager::WorldManager() {
+	reloadListener = HotReload::subscribe([this](const AssetChange& change) {
+		this->onAssetReloaded(change);
+	});
+}
+
+WorldManager::~WorldManager() {
+	HotReload::unsubscribe(reloadListener);
+}
+
+/*
+ *  Zasób przeładowany w trakcie gry - mapa podmieniana jest w miejscu, więc wystarczy poprawić
+ *  pozycję gracza (mapa mogła się zmniejszyć) oraz muzykę i dźwięki, a po zmianie przedmiotów
+ *  przyciąć stacki do nowych limitów i przeliczyć statystyki gracza
+ */
+void WorldManager::onAssetReloaded(const AssetChange& change) {
+	if(change.kind == AssetKind::ItemList) {
+		player.getInventory().clampStacks();
+		player.notifyStatsChanged();
+		return;
+	}
+
+	if(change.kind != AssetKind::Map || change.name != currentMapName || !currentMap)
+		return;
+
+	Vec2u worldPos = player.getWorldPosition();
+	if(worldPos.x >= currentMap->getWidth() || worldPos.y >= currentMap->getHeight()) {
+		worldPos.x = std::min(worldPos.x, currentMap->getWidth() - 1);
+		worldPos.y = std::min(worldPos.y, currentMap->getHeight() - 1);
+		player.setPosition(worldPos);
+	}
+	SoundEngine::get().preload(currentMap->sfxManifest());
+	SoundEngine::get().playMusic(currentMap->music(), true);
+}
 
 void WorldManager::setCurrentMap(const std::string &mapName) {
 	try {
 		currentMap = AssetManager::getMap(mapName);
 		currentMap->bindPlayer(player);
 		currentMapName = mapName;
+		SoundEngine::get().preload(currentMap->sfxManifest());
 		std::cout << "play music: '" << currentMap->music() << "'\n";
-		if(!currentMap->music().empty())
-			SoundEngine::get().playMusic(currentMap->music(), true);
+		SoundEngine::get().playMusic(currentMap->music(), true);
 	} catch (std::exception&) {
 		std::cerr << "Failed loading map " << mapName << "\n";
 		return;
@@ -49,6 +86,7 @@ bool WorldManager::playerInteract() {
  *  Ogólna funkcja do wyrenderowania całej mapy do danego targetu
  */
 void WorldManager::draw(sf::RenderTarget &target) {
+	PROFILE_SCOPE("World draw");
 	if(MapTravel.isTravelling) {
 		//  Fade out
 		if(MapTravel.currentMapTravelTime < 0) {
@@ -91,6 +129,7 @@ void WorldManager::draw(sf::RenderTarget &target) {
  *  Aktualizuje wszystkich aktorów świata oraz inne animacje
  */
 void WorldManager::updateWorld() {
+	PROFILE_SCOPE("World update");
 	if(s_should_save_game) {
 		saveGame();
 		s_should_save_game = false;
@@ -99,6 +138,12 @@ void WorldManager::updateWorld() {
 	if(s_should_load_game) {
 		loadGame();
 		s_should_load_game = false;
+		s_should_autosave = false;
+	}
+
+	if(s_should_autosave) {
+		autosave();
+		s_should_autosave = false;
 	}
 
 	player.update();
@@ -121,7 +166,9 @@ bool WorldManager::handleMapTransfer(Connection conn) {
 	worldPos.x = std::clamp(worldPos.x, 0u, this->currentMap->getWidth());
 	worldPos.y = std::clamp(worldPos.y, 0u, this->currentMap->getHeight());
 	player.setPosition(worldPos);
-} 
+	shouldAutosave();
+	return true;
+}
 
 void WorldManager::shouldSaveGame() {
 	s_should_save_game = true;
@@ -131,13 +178,28 @@ void WorldManager::shouldLoadGame() {
 	s_should_load_game = true;
 }
 
+void WorldManager::shouldAutosave() {
+	s_should_autosave = true;
+}
+
 void WorldManager::saveGame() {
 	auto save = AssetManager::getSavefile();
 	save.set("playerCurrentMap", currentMapName);
 	save.set("playerCurrentPos", player.getWorldPosition());
 	player.saveToSavegame();
 	save.saveToFile();
-	std::cout << "Game saved successfully\n";
+}
+
+/*
+ *  Autozapis - te same dane co przy pełnym zapisie, ale na dysk trafiają jedynie
+ *  zmienione pola, dopisywane do dziennika zapisu
+ */
+void WorldManager::autosave() {
+	auto save = AssetManager::getSavefile();
+	save.set("playerCurrentMap", currentMapName);
+	save.set("playerCurrentPos", player.getWorldPosition());
+	player.saveToSavegame();
+	save.commit();
 }
 
 void WorldManager::loadGame() {
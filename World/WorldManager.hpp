@@ -15,13 +15,20 @@ class WorldManager {
 		int currentMapTravelTime {0};
 	} MapTravel;
 
+	HotReload::ListenerID reloadListener;
+
 	void saveGame();
+	void autosave();
 	void loadGame();
+	void onAssetReloaded(const AssetChange& change);
 public:
 	static void shouldSaveGame();
 	static void shouldLoadGame();
+	static void shouldAutosave();
 
-	WorldManager() {}
+	WorldManager();
+	~WorldManager();
+	WorldManager(const WorldManager&) = delete;
 
 	Map& getMap() {
 		if(!currentMap)